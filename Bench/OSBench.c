@@ -0,0 +1,809 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#include "TINIUX.h"
+#include "OSBench.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( OS_MEMFREE_ON==0 ) || ( OS_SEMAPHORE_ON==0 ) || ( OS_MSGQ_ON==0 )
+  #error "The benchmarks need SETOS_ENABLE_MEMFREE, SETOS_USE_SEMAPHORE and SETOS_USE_MSGQ"
+#endif
+
+#define OSBENCH_MEM_BLOCKS          ( 24U )
+#define OSBENCH_TIMER_LOOPS         ( 100U )
+#define OSBENCH_SLICE_TASKS         ( 3U )
+#define OSBENCH_SLICE_RUN_TICKS     ( 100U )
+#define OSBENCH_READ_TASKS          ( 3U )
+#define OSBENCH_READ_LOOPS          ( 20U )
+#define OSBENCH_TOPIC_MAX_SUBS      ( 8U )
+#define OSBENCH_TOPIC_SAMPLE_SIZE   ( 16U )
+
+TINIUX_DATA static OSSemHandle_t      gBenchDoneSem             = OS_NULL;
+TINIUX_DATA static OSSemHandle_t      gBenchSem                 = OS_NULL;
+
+TINIUX_DATA static volatile uOS32_t   guiBenchStart             = 0UL;
+TINIUX_DATA static volatile uOS32_t   guiBenchEnd               = 0UL;
+TINIUX_DATA static volatile uOS32_t   guiBenchSum               = 0UL;
+TINIUX_DATA static volatile uOS32_t   guiBenchMax               = 0UL;
+TINIUX_DATA static volatile uOSBase_t guxBenchFinished          = ( uOSBase_t ) 0U;
+#if ( OSTIME_SLICE_ON!=0 )
+TINIUX_DATA static volatile uOSTick_t guxBenchSpinStart         = ( uOSTick_t ) 0U;
+TINIUX_DATA static void * volatile    gpvBenchSpinLast          = OS_NULL;
+TINIUX_DATA static volatile uOS32_t   guiBenchSpinLoops[ OSBENCH_SLICE_TASKS ];
+TINIUX_DATA static volatile uOS32_t   guiBenchSpinTurns[ OSBENCH_SLICE_TASKS ];
+#endif //( OSTIME_SLICE_ON!=0 )
+#if ( OSTIME_SLICE_ON!=0 ) && ( OS_RWLOCK_ON!=0 ) && ( OS_MUTEX_ON!=0 )
+TINIUX_DATA static OSRWLockHandle_t   gBenchReadRWLock          = OS_NULL;
+TINIUX_DATA static OSMutexHandle_t    gBenchReadMutex           = OS_NULL;
+TINIUX_DATA static volatile uOS32_t   guiBenchShared            = 0UL;
+TINIUX_DATA static volatile uOS32_t   guiBenchReads[ OSBENCH_READ_TASKS ];
+#endif //( OSTIME_SLICE_ON!=0 ) && ( OS_RWLOCK_ON!=0 ) && ( OS_MUTEX_ON!=0 )
+#if ( OS_TOPIC_ON!=0 )
+TINIUX_DATA static uOSBase_t          guxBenchSubNum            = ( uOSBase_t ) 0U;
+#endif //( OS_TOPIC_ON!=0 )
+
+char * OSBenchAppend( char * pcTo, const char * pcText )
+{
+    while( *pcText != '\0' )
+    {
+        *pcTo++ = *pcText++;
+    }
+    *pcTo = '\0';
+
+    return pcTo;
+}
+
+char * OSBenchAppendNum( char * pcTo, uOS32_t uiValue )
+{
+    char cDigit[ 11 ];
+    uOSBase_t uxNum = ( uOSBase_t ) 0U;
+
+    do
+    {
+        cDigit[ uxNum++ ] = ( char ) ( '0' + ( uiValue % 10UL ) );
+        uiValue /= 10UL;
+    } while( uiValue != 0UL );
+
+    while( uxNum > ( uOSBase_t ) 0U )
+    {
+        *pcTo++ = cDigit[ --uxNum ];
+    }
+    *pcTo = '\0';
+
+    return pcTo;
+}
+
+/* One line: the name, an optional parameter, the cycles per operation and
+the worst operation when it was recorded. */
+static void OSBenchReport( const char * pcName, uOS32_t uiParam, uOS32_t uiCycles, uOS32_t uiOps, uOS32_t uiMax )
+{
+    char cLine[ OSBENCH_LINE_LEN ];
+    char * pcTo = cLine;
+
+    pcTo = OSBenchAppend( pcTo, pcName );
+    if( uiParam != 0UL )
+    {
+        pcTo = OSBenchAppend( pcTo, " " );
+        pcTo = OSBenchAppendNum( pcTo, uiParam );
+    }
+    pcTo = OSBenchAppend( pcTo, ": " );
+    pcTo = OSBenchAppendNum( pcTo, ( uiOps != 0UL ) ? ( uiCycles / uiOps ) : 0UL );
+    pcTo = OSBenchAppend( pcTo, " cycles/op" );
+    if( uiMax != 0UL )
+    {
+        pcTo = OSBenchAppend( pcTo, ", max " );
+        pcTo = OSBenchAppendNum( pcTo, uiMax );
+    }
+    pcTo = OSBenchAppend( pcTo, ", " );
+    pcTo = OSBenchAppendNum( pcTo, uiOps );
+    ( void ) OSBenchAppend( pcTo, " ops\n" );
+
+    OSBenchOutput( cLine );
+}
+
+static void OSBenchRecord( uOS32_t uiCycles )
+{
+    guiBenchSum += uiCycles;
+    if( uiCycles > guiBenchMax )
+    {
+        guiBenchMax = uiCycles;
+    }
+}
+
+static void OSBenchYieldTask( void * pvParameter )
+{
+    uOS32_t x = 0UL;
+
+    ( void ) pvParameter;
+
+    for( x = 0UL; x < OSBENCH_LOOPS; x++ )
+    {
+        OSTaskYield();
+    }
+
+    /* The second task to finish ends the measurement. */
+    OSIntLock();
+    {
+        guxBenchFinished++;
+        if( guxBenchFinished == ( uOSBase_t ) 2U )
+        {
+            guiBenchEnd = OSBENCH_CYCLES();
+        }
+    }
+    OSIntUnlock();
+
+    ( void ) OSSemPost( gBenchDoneSem );
+    OSTaskDelete( OS_NULL );
+}
+
+/* Two tasks of the same priority yield to each other, every yield is a
+switch. */
+static void OSBenchYield( void )
+{
+    guxBenchFinished = ( uOSBase_t ) 0U;
+
+    OSScheduleLock();
+    {
+        ( void ) OSTaskCreate( OSBenchYieldTask, OS_NULL, OSBENCH_STACK_SIZE, OSBENCH_PRIO + 1U, ( sOS8_t * ) "yieldA" );
+        ( void ) OSTaskCreate( OSBenchYieldTask, OS_NULL, OSBENCH_STACK_SIZE, OSBENCH_PRIO + 1U, ( sOS8_t * ) "yieldB" );
+        guiBenchStart = OSBENCH_CYCLES();
+    }
+    ( void ) OSScheduleUnlock();
+
+    ( void ) OSSemPend( gBenchDoneSem, OSPEND_FOREVER_VALUE );
+    ( void ) OSSemPend( gBenchDoneSem, OSPEND_FOREVER_VALUE );
+
+    OSBenchReport( "yield switch", 0UL, guiBenchEnd - guiBenchStart, OSBENCH_LOOPS * 2UL, 0UL );
+}
+
+static void OSBenchSemTask( void * pvParameter )
+{
+    uOS32_t x = 0UL;
+
+    ( void ) pvParameter;
+
+    for( x = 0UL; x < OSBENCH_LOOPS; x++ )
+    {
+        ( void ) OSSemPend( gBenchSem, OSPEND_FOREVER_VALUE );
+        OSBenchRecord( OSBENCH_CYCLES() - guiBenchStart );
+    }
+
+    ( void ) OSSemPost( gBenchDoneSem );
+    OSTaskDelete( OS_NULL );
+}
+
+/* From OSSemPost in this task to the return of OSSemPend in a higher
+priority task. */
+static void OSBenchSemWake( void )
+{
+    uOS32_t x = 0UL;
+
+    guiBenchSum = 0UL;
+    guiBenchMax = 0UL;
+
+    ( void ) OSTaskCreate( OSBenchSemTask, OS_NULL, OSBENCH_STACK_SIZE, OSBENCH_PRIO + 2U, ( sOS8_t * ) "semwake" );
+
+    for( x = 0UL; x < OSBENCH_LOOPS; x++ )
+    {
+        guiBenchStart = OSBENCH_CYCLES();
+        ( void ) OSSemPost( gBenchSem );
+    }
+
+    ( void ) OSSemPend( gBenchDoneSem, OSPEND_FOREVER_VALUE );
+
+    OSBenchReport( "sem post->pend wake", 0UL, guiBenchSum, OSBENCH_LOOPS, guiBenchMax );
+}
+
+static void OSBenchMsgQ( uOSBase_t uxItemSize )
+{
+    uOS32_t auiItem[ 64U / sizeof( uOS32_t ) ];
+    OSMsgQHandle_t MsgQHandle = OS_NULL;
+    uOS32_t uiSend = 0UL;
+    uOS32_t uiReceive = 0UL;
+    uOS32_t uiStart = 0UL;
+    uOS32_t uiMiddle = 0UL;
+    uOS32_t x = 0UL;
+
+    MsgQHandle = OSMsgQCreate( ( uOSBase_t ) 4U, uxItemSize );
+    if( MsgQHandle == OS_NULL )
+    {
+        OSBenchOutput( "msgq: out of memory\n" );
+        return;
+    }
+
+    for( x = 0UL; x < OSBENCH_LOOPS; x++ )
+    {
+        uiStart = OSBENCH_CYCLES();
+        ( void ) OSMsgQSend( MsgQHandle, auiItem, ( uOSTick_t ) 0U );
+        uiMiddle = OSBENCH_CYCLES();
+        ( void ) OSMsgQReceive( MsgQHandle, auiItem, ( uOSTick_t ) 0U );
+        uiReceive += OSBENCH_CYCLES() - uiMiddle;
+        uiSend += uiMiddle - uiStart;
+    }
+
+    OSMsgQDelete( MsgQHandle );
+
+    OSBenchReport( "msgq send, bytes", ( uOS32_t ) uxItemSize, uiSend, OSBENCH_LOOPS, 0UL );
+    OSBenchReport( "msgq receive, bytes", ( uOS32_t ) uxItemSize, uiReceive, OSBENCH_LOOPS, 0UL );
+}
+
+TINIUX_DATA static OSMsgQHandle_t     gBenchRequestQ            = OS_NULL;
+TINIUX_DATA static OSMsgQHandle_t     gBenchReplyQ              = OS_NULL;
+
+static void OSBenchMsgQServerTask( void * pvParameter )
+{
+    uOS32_t uiMsg = 0UL;
+    uOS32_t x = 0UL;
+
+    ( void ) pvParameter;
+
+    for( x = 0UL; x < OSBENCH_LOOPS; x++ )
+    {
+        ( void ) OSMsgQReceive( gBenchRequestQ, &uiMsg, OSPEND_FOREVER_VALUE );
+        uiMsg++;
+        ( void ) OSMsgQSend( gBenchReplyQ, &uiMsg, OSPEND_FOREVER_VALUE );
+    }
+
+    OSTaskDelete( OS_NULL );
+}
+
+/* A request and its reply through a pair of message queues, served by a
+task of a higher priority. */
+static void OSBenchMsgQRoundTrip( void )
+{
+    uOS32_t uiMsg = 0UL;
+    uOS32_t x = 0UL;
+
+    gBenchRequestQ = OSMsgQCreate( ( uOSBase_t ) 1U, ( uOSBase_t ) sizeof( uOS32_t ) );
+    gBenchReplyQ = OSMsgQCreate( ( uOSBase_t ) 1U, ( uOSBase_t ) sizeof( uOS32_t ) );
+    if( ( gBenchRequestQ == OS_NULL ) || ( gBenchReplyQ == OS_NULL ) ||
+        ( OSTaskCreate( OSBenchMsgQServerTask, OS_NULL, OSBENCH_STACK_SIZE, OSBENCH_PRIO + 1U, ( sOS8_t * ) "msgqsrv" ) == OS_NULL ) )
+    {
+        OSBenchOutput( "msgq round trip: out of memory\n" );
+        return;
+    }
+
+    guiBenchStart = OSBENCH_CYCLES();
+    for( x = 0UL; x < OSBENCH_LOOPS; x++ )
+    {
+        uiMsg = x;
+        ( void ) OSMsgQSend( gBenchRequestQ, &uiMsg, OSPEND_FOREVER_VALUE );
+        ( void ) OSMsgQReceive( gBenchReplyQ, &uiMsg, OSPEND_FOREVER_VALUE );
+    }
+    guiBenchEnd = OSBENCH_CYCLES();
+
+    OSMsgQDelete( gBenchRequestQ );
+    OSMsgQDelete( gBenchReplyQ );
+
+    OSBenchReport( "msgq request/reply round trip", 0UL, guiBenchEnd - guiBenchStart, OSBENCH_LOOPS, 0UL );
+}
+
+#if ( OS_TASK_IPC_ON!=0 )
+static void OSBenchIPCServerTask( void * pvParameter )
+{
+    OSTaskHandle_t ClientHandle = OS_NULL;
+    uOS32_t uiMsg = 0UL;
+    uOS32_t x = 0UL;
+
+    ( void ) pvParameter;
+
+    for( x = 0UL; x < OSBENCH_LOOPS; x++ )
+    {
+        ( void ) OSTaskReplyWait( ClientHandle, uiMsg + 1UL, &ClientHandle, &uiMsg, OSPEND_FOREVER_VALUE );
+    }
+
+    /* Reply to the last call without waiting for another one. */
+    ( void ) OSTaskReplyWait( ClientHandle, uiMsg + 1UL, OS_NULL, OS_NULL, ( uOSTick_t ) 0U );
+
+    OSTaskDelete( OS_NULL );
+}
+
+/* The same round trip as OSBenchMsgQRoundTrip with OSTaskCall and
+OSTaskReplyWait, which switch straight to the partner. */
+static void OSBenchIPCRoundTrip( void )
+{
+    OSTaskHandle_t ServerHandle = OS_NULL;
+    uOS32_t uiReply = 0UL;
+    uOS32_t x = 0UL;
+
+    ServerHandle = OSTaskCreate( OSBenchIPCServerTask, OS_NULL, OSBENCH_STACK_SIZE, OSBENCH_PRIO + 1U, ( sOS8_t * ) "ipcsrv" );
+    if( ServerHandle == OS_NULL )
+    {
+        OSBenchOutput( "ipc round trip: out of memory\n" );
+        return;
+    }
+
+    guiBenchStart = OSBENCH_CYCLES();
+    for( x = 0UL; x < OSBENCH_LOOPS; x++ )
+    {
+        ( void ) OSTaskCall( ServerHandle, x, &uiReply, OSPEND_FOREVER_VALUE );
+    }
+    guiBenchEnd = OSBENCH_CYCLES();
+
+    OSBenchReport( "ipc call/reply round trip", 0UL, guiBenchEnd - guiBenchStart, OSBENCH_LOOPS, 0UL );
+}
+#endif //( OS_TASK_IPC_ON!=0 )
+
+/* Every other block of a run of mixed sizes is freed first, so the heap is
+fragmented while it is measured. */
+static void OSBenchMem( void )
+{
+    void * apvBlock[ OSBENCH_MEM_BLOCKS ];
+    void * pvMem = OS_NULL;
+    uOS32_t uiMalloc = 0UL;
+    uOS32_t uiFree = 0UL;
+    uOS32_t uiStart = 0UL;
+    uOS32_t uiOps = 0UL;
+    uOS32_t x = 0UL;
+
+    for( x = 0UL; x < OSBENCH_MEM_BLOCKS; x++ )
+    {
+        apvBlock[ x ] = OSMemMalloc( ( uOSMemSize_t ) ( 16UL + ( x % 4UL ) * 32UL ) );
+    }
+    for( x = 1UL; x < OSBENCH_MEM_BLOCKS; x += 2UL )
+    {
+        if( apvBlock[ x ] != OS_NULL )
+        {
+            OSMemFree( apvBlock[ x ] );
+            apvBlock[ x ] = OS_NULL;
+        }
+    }
+
+    for( x = 0UL; x < OSBENCH_LOOPS; x++ )
+    {
+        uiStart = OSBENCH_CYCLES();
+        pvMem = OSMemMalloc( ( uOSMemSize_t ) ( 24UL + ( x % 4UL ) * 24UL ) );
+        uiMalloc += OSBENCH_CYCLES() - uiStart;
+        if( pvMem != OS_NULL )
+        {
+            uiStart = OSBENCH_CYCLES();
+            OSMemFree( pvMem );
+            uiFree += OSBENCH_CYCLES() - uiStart;
+            uiOps++;
+        }
+    }
+
+    for( x = 0UL; x < OSBENCH_MEM_BLOCKS; x++ )
+    {
+        if( apvBlock[ x ] != OS_NULL )
+        {
+            OSMemFree( apvBlock[ x ] );
+        }
+    }
+
+    OSBenchReport( "malloc fragmented", 0UL, uiMalloc, OSBENCH_LOOPS, 0UL );
+    OSBenchReport( "free fragmented", 0UL, uiFree, uiOps, 0UL );
+}
+
+#if ( OSTIME_SLICE_ON!=0 )
+/* Spins for OSBENCH_SLICE_RUN_TICKS, counting its loops and the turns it got
+the CPU back from another spinning task. */
+static void OSBenchSpinTask( void * pvParameter )
+{
+    uOSBase_t const uxIndex = ( uOSBase_t ) ( ( volatile uOS32_t * ) pvParameter - guiBenchSpinLoops );
+
+    while( ( OSGetTickCount() - guxBenchSpinStart ) < ( uOSTick_t ) OSBENCH_SLICE_RUN_TICKS )
+    {
+        if( gpvBenchSpinLast != pvParameter )
+        {
+            gpvBenchSpinLast = pvParameter;
+            guiBenchSpinTurns[ uxIndex ]++;
+        }
+        guiBenchSpinLoops[ uxIndex ]++;
+    }
+
+    OSTaskDelete( OS_NULL );
+}
+
+/* CPU-bound tasks of one priority share the CPU in turns of uxTicks, a
+longer turn takes fewer context switches for the same work. */
+static void OSBenchTimeSlice( uOSTick_t uxTicks )
+{
+    char cLine[ OSBENCH_LINE_LEN ];
+    char * pcTo = cLine;
+    OSTaskHandle_t TaskHandle = OS_NULL;
+    uOS32_t uiTurns = 0UL;
+    uOS32_t uiLoops = 0UL;
+    uOSBase_t x = ( uOSBase_t ) 0U;
+
+    gpvBenchSpinLast = OS_NULL;
+
+    /* The spinning tasks run above this task, which goes on once all of
+    them are done. */
+    OSScheduleLock();
+    {
+        for( x = ( uOSBase_t ) 0U; x < ( uOSBase_t ) OSBENCH_SLICE_TASKS; x++ )
+        {
+            guiBenchSpinLoops[ x ] = 0UL;
+            guiBenchSpinTurns[ x ] = 0UL;
+            TaskHandle = OSTaskCreate( OSBenchSpinTask, ( void * ) &guiBenchSpinLoops[ x ], OSBENCH_STACK_SIZE, OSBENCH_PRIO + 1U, ( sOS8_t * ) "spin" );
+            if( TaskHandle != OS_NULL )
+            {
+                OSTaskSetTimeSlice( TaskHandle, uxTicks );
+            }
+        }
+        guxBenchSpinStart = OSGetTickCount();
+    }
+    ( void ) OSScheduleUnlock();
+
+    for( x = ( uOSBase_t ) 0U; x < ( uOSBase_t ) OSBENCH_SLICE_TASKS; x++ )
+    {
+        uiTurns += guiBenchSpinTurns[ x ];
+        uiLoops += guiBenchSpinLoops[ x ];
+    }
+
+    pcTo = OSBenchAppend( pcTo, "time slice " );
+    pcTo = OSBenchAppendNum( pcTo, ( uOS32_t ) uxTicks );
+    pcTo = OSBenchAppend( pcTo, " ticks: " );
+    pcTo = OSBenchAppendNum( pcTo, uiTurns );
+    pcTo = OSBenchAppend( pcTo, " switches, " );
+    pcTo = OSBenchAppendNum( pcTo, uiLoops );
+    ( void ) OSBenchAppend( pcTo, " loops\n" );
+    OSBenchOutput( cLine );
+}
+#endif //( OSTIME_SLICE_ON!=0 )
+
+#if ( OSTIME_SLICE_ON!=0 ) && ( OS_RWLOCK_ON!=0 ) && ( OS_MUTEX_ON!=0 )
+/* Reads the shared value under the reader-writer lock, or under the mutex
+when no lock was created, until the run is over. */
+static void OSBenchReadTask( void * pvParameter )
+{
+    uOSBase_t const uxIndex = ( uOSBase_t ) ( ( volatile uOS32_t * ) pvParameter - guiBenchReads );
+    volatile uOS32_t uiValue = 0UL;
+    uOS32_t x = 0UL;
+
+    while( ( OSGetTickCount() - guxBenchSpinStart ) < ( uOSTick_t ) OSBENCH_SLICE_RUN_TICKS )
+    {
+        if( gBenchReadRWLock != OS_NULL )
+        {
+            ( void ) OSRWLockReadLock( gBenchReadRWLock, OSPEND_FOREVER_VALUE );
+        }
+        else
+        {
+            ( void ) OSMutexLock( gBenchReadMutex, OSPEND_FOREVER_VALUE );
+        }
+
+        for( x = 0UL; x < OSBENCH_READ_LOOPS; x++ )
+        {
+            uiValue += guiBenchShared;
+        }
+
+        if( gBenchReadRWLock != OS_NULL )
+        {
+            ( void ) OSRWLockReadUnlock( gBenchReadRWLock );
+        }
+        else
+        {
+            ( void ) OSMutexUnlock( gBenchReadMutex );
+        }
+        guiBenchReads[ uxIndex ]++;
+    }
+
+    OSTaskDelete( OS_NULL );
+}
+
+/* Readers at one priority switched every tick, a reader holding the lock
+when its turn ends blocks the others on the mutex but not on the
+reader-writer lock. */
+static void OSBenchReaders( uOSBool_t bRWLock )
+{
+    char cLine[ OSBENCH_LINE_LEN ];
+    char * pcTo = cLine;
+    OSTaskHandle_t TaskHandle = OS_NULL;
+    uOS32_t uiReads = 0UL;
+    uOSBase_t x = ( uOSBase_t ) 0U;
+
+    if( bRWLock != OS_FALSE )
+    {
+        gBenchReadRWLock = OSRWLockCreate();
+        if( gBenchReadRWLock == OS_NULL )
+        {
+            return;
+        }
+    }
+    else
+    {
+        gBenchReadMutex = OSMutexCreate();
+        if( gBenchReadMutex == OS_NULL )
+        {
+            return;
+        }
+    }
+
+    OSScheduleLock();
+    {
+        for( x = ( uOSBase_t ) 0U; x < ( uOSBase_t ) OSBENCH_READ_TASKS; x++ )
+        {
+            guiBenchReads[ x ] = 0UL;
+            TaskHandle = OSTaskCreate( OSBenchReadTask, ( void * ) &guiBenchReads[ x ], OSBENCH_STACK_SIZE, OSBENCH_PRIO + 1U, ( sOS8_t * ) "reader" );
+            if( TaskHandle != OS_NULL )
+            {
+                OSTaskSetTimeSlice( TaskHandle, ( uOSTick_t ) 1U );
+            }
+        }
+        guxBenchSpinStart = OSGetTickCount();
+    }
+    ( void ) OSScheduleUnlock();
+
+    for( x = ( uOSBase_t ) 0U; x < ( uOSBase_t ) OSBENCH_READ_TASKS; x++ )
+    {
+        uiReads += guiBenchReads[ x ];
+    }
+
+    if( bRWLock != OS_FALSE )
+    {
+        OSRWLockDelete( gBenchReadRWLock );
+        gBenchReadRWLock = OS_NULL;
+    }
+    else
+    {
+        OSMutexDelete( gBenchReadMutex );
+        gBenchReadMutex = OS_NULL;
+    }
+
+    pcTo = OSBenchAppend( pcTo, ( bRWLock != OS_FALSE ) ? "rwlock" : "mutex" );
+    pcTo = OSBenchAppend( pcTo, " readers, " );
+    pcTo = OSBenchAppendNum( pcTo, ( uOS32_t ) OSBENCH_READ_TASKS );
+    pcTo = OSBenchAppend( pcTo, " tasks: " );
+    pcTo = OSBenchAppendNum( pcTo, uiReads );
+    pcTo = OSBenchAppend( pcTo, " reads in " );
+    pcTo = OSBenchAppendNum( pcTo, ( uOS32_t ) OSBENCH_SLICE_RUN_TICKS );
+    ( void ) OSBenchAppend( pcTo, " ticks\n" );
+    OSBenchOutput( cLine );
+}
+#endif //( OSTIME_SLICE_ON!=0 ) && ( OS_RWLOCK_ON!=0 ) && ( OS_MUTEX_ON!=0 )
+
+#if ( OS_TIMER_ON!=0 )
+static void OSBenchTimerCallback( void * pvParameter )
+{
+    ( void ) pvParameter;
+
+    guiBenchEnd = OSBENCH_CYCLES();
+    ( void ) OSSemPost( gBenchSem );
+}
+
+/* Start and stop are commands to the timer task, the expiry is measured
+from a start just after a tick to the callback one tick later. */
+static void OSBenchTimer( void )
+{
+    OSTimerHandle_t TimerHandle = OS_NULL;
+    uOS32_t uiStartCmd = 0UL;
+    uOS32_t uiStopCmd = 0UL;
+    uOS32_t uiStart = 0UL;
+    uOS32_t x = 0UL;
+
+    TimerHandle = OSTimerCreate( ( uOSTick_t ) 1U, ( uOS16_t ) 0U, OSBenchTimerCallback, OS_NULL, ( sOS8_t * ) "bench" );
+    if( TimerHandle == OS_NULL )
+    {
+        OSBenchOutput( "timer: out of memory\n" );
+        return;
+    }
+
+    for( x = 0UL; x < OSBENCH_LOOPS; x++ )
+    {
+        uiStart = OSBENCH_CYCLES();
+        ( void ) OSTimerStart( TimerHandle );
+        uiStartCmd += OSBENCH_CYCLES() - uiStart;
+
+        uiStart = OSBENCH_CYCLES();
+        ( void ) OSTimerStop( TimerHandle );
+        uiStopCmd += OSBENCH_CYCLES() - uiStart;
+    }
+    OSBenchReport( "timer start", 0UL, uiStartCmd, OSBENCH_LOOPS, 0UL );
+    OSBenchReport( "timer stop", 0UL, uiStopCmd, OSBENCH_LOOPS, 0UL );
+
+    OSTaskSleep( ( uOSTick_t ) 1U );
+    uiStart = OSBENCH_CYCLES();
+    OSTaskSleep( ( uOSTick_t ) 10U );
+    OSBenchReport( "tick period", 0UL, OSBENCH_CYCLES() - uiStart, 10UL, 0UL );
+
+    guiBenchSum = 0UL;
+    guiBenchMax = 0UL;
+    for( x = 0UL; x < OSBENCH_TIMER_LOOPS; x++ )
+    {
+        OSTaskSleep( ( uOSTick_t ) 1U );
+        uiStart = OSBENCH_CYCLES();
+        ( void ) OSTimerStart( TimerHandle );
+        ( void ) OSSemPend( gBenchSem, OSPEND_FOREVER_VALUE );
+        OSBenchRecord( guiBenchEnd - uiStart );
+    }
+    OSBenchReport( "timer 1 tick expire", 0UL, guiBenchSum, OSBENCH_TIMER_LOOPS, guiBenchMax );
+
+    ( void ) OSTimerDelete( TimerHandle );
+}
+#endif //( OS_TIMER_ON!=0 )
+
+#if ( OS_TOPIC_ON!=0 )
+static void OSBenchTopicTask( void * pvParameter )
+{
+    OSTopicSubHandle_t const SubHandle = ( OSTopicSubHandle_t ) pvParameter;
+    void * pvSample = OS_NULL;
+    uOS32_t x = 0UL;
+
+    for( x = 0UL; x < OSBENCH_LOOPS; x++ )
+    {
+        pvSample = OSTopicReceive( SubHandle, OSPEND_FOREVER_VALUE );
+        if( pvSample != OS_NULL )
+        {
+            OSTopicRelease( SubHandle, pvSample );
+        }
+    }
+
+    /* The last subscriber to finish ends the measurement. */
+    OSIntLock();
+    {
+        guxBenchFinished++;
+        if( guxBenchFinished == guxBenchSubNum )
+        {
+            guiBenchEnd = OSBENCH_CYCLES();
+            ( void ) OSSemPost( gBenchSem );
+        }
+    }
+    OSIntUnlock();
+
+    OSTaskDelete( OS_NULL );
+}
+
+/* A sample published to uxSubNum subscriber tasks of a higher priority,
+until every one of them has received and released it. Topics can not be
+deleted, so each run leaves its topic and subscribers on the heap. */
+static void OSBenchTopic( uOSBase_t uxSubNum )
+{
+    OSTopicHandle_t TopicHandle = OS_NULL;
+    OSTopicSubHandle_t SubHandle = OS_NULL;
+    uOS32_t * puiSample = OS_NULL;
+    uOS32_t uiOps = 0UL;
+    uOS32_t x = 0UL;
+
+    TopicHandle = OSTopicCreate( ( uOSMemSize_t ) OSBENCH_TOPIC_SAMPLE_SIZE, uxSubNum + ( uOSBase_t ) 1U );
+    if( TopicHandle == OS_NULL )
+    {
+        OSBenchOutput( "topic: out of memory\n" );
+        return;
+    }
+
+    guxBenchFinished = ( uOSBase_t ) 0U;
+    guxBenchSubNum = uxSubNum;
+    for( x = 0UL; x < ( uOS32_t ) uxSubNum; x++ )
+    {
+        SubHandle = OSTopicSubscribe( TopicHandle, ( uOSBase_t ) 1U, OSTOPIC_QUEUED );
+        if( ( SubHandle == OS_NULL ) ||
+            ( OSTaskCreate( OSBenchTopicTask, ( void * ) SubHandle, OSBENCH_STACK_SIZE, OSBENCH_PRIO + 1U, ( sOS8_t * ) "topic" ) == OS_NULL ) )
+        {
+            OSBenchOutput( "topic: out of memory\n" );
+            return;
+        }
+    }
+
+    guiBenchStart = OSBENCH_CYCLES();
+    for( x = 0UL; x < OSBENCH_LOOPS; x++ )
+    {
+        /* The subscribers run first, so the sample published last is
+        free again by now. */
+        puiSample = ( uOS32_t * ) OSTopicSampleAlloc( TopicHandle );
+        if( puiSample != OS_NULL )
+        {
+            *puiSample = x;
+            if( OSTopicPublish( TopicHandle, puiSample ) == uxSubNum )
+            {
+                uiOps++;
+            }
+        }
+    }
+
+    if( uiOps != OSBENCH_LOOPS )
+    {
+        OSBenchOutput( "topic: samples lost\n" );
+        return;
+    }
+    ( void ) OSSemPend( gBenchSem, OSPEND_FOREVER_VALUE );
+
+    OSBenchReport( "topic publish->release, subscribers", ( uOS32_t ) uxSubNum, guiBenchEnd - guiBenchStart, uiOps, 0UL );
+}
+#endif //( OS_TOPIC_ON!=0 )
+
+static void OSBenchTask( void * pvParameter )
+{
+    char cLine[ OSBENCH_LINE_LEN ];
+    char * pcTo = cLine;
+
+    ( void ) pvParameter;
+
+    pcTo = OSBenchAppend( pcTo, "TINIUX bench, quick schedule " );
+    pcTo = OSBenchAppendNum( pcTo, ( uOS32_t ) OSQUICK_SCHEDULE_ON );
+    pcTo = OSBenchAppend( pcTo, ", time slice " );
+    pcTo = OSBenchAppendNum( pcTo, ( uOS32_t ) OSTIME_SLICE_ON );
+    ( void ) OSBenchAppend( pcTo, "\n" );
+    OSBenchOutput( cLine );
+
+    OSBenchYield();
+    OSBenchSemWake();
+    OSBenchMsgQ( ( uOSBase_t ) 4U );
+    OSBenchMsgQ( ( uOSBase_t ) 16U );
+    OSBenchMsgQ( ( uOSBase_t ) 64U );
+    OSBenchMsgQRoundTrip();
+#if ( OS_TASK_IPC_ON!=0 )
+    OSBenchIPCRoundTrip();
+#endif //( OS_TASK_IPC_ON!=0 )
+    OSBenchMem();
+#if ( OS_TIMER_ON!=0 )
+    OSBenchTimer();
+#endif //( OS_TIMER_ON!=0 )
+#if ( OSTIME_SLICE_ON!=0 )
+    OSBenchTimeSlice( ( uOSTick_t ) 1U );
+    OSBenchTimeSlice( ( uOSTick_t ) OSBENCH_SLICE_TICKS );
+#endif //( OSTIME_SLICE_ON!=0 )
+#if ( OSTIME_SLICE_ON!=0 ) && ( OS_RWLOCK_ON!=0 ) && ( OS_MUTEX_ON!=0 )
+    OSBenchReaders( OS_FALSE );
+    OSBenchReaders( OS_TRUE );
+#endif //( OSTIME_SLICE_ON!=0 ) && ( OS_RWLOCK_ON!=0 ) && ( OS_MUTEX_ON!=0 )
+#if ( OS_TOPIC_ON!=0 )
+    OSBenchTopic( ( uOSBase_t ) 1U );
+    OSBenchTopic( ( uOSBase_t ) 2U );
+    OSBenchTopic( ( uOSBase_t ) 4U );
+    OSBenchTopic( ( uOSBase_t ) OSBENCH_TOPIC_MAX_SUBS );
+#endif //( OS_TOPIC_ON!=0 )
+
+    OSBenchDone();
+
+    OSTaskSuspend( OS_NULL );
+}
+
+/* Call before OSStart, the results are printed by OSBenchOutput. */
+uOSBool_t OSBenchCreate( void )
+{
+    gBenchDoneSem = OSSemCreateCount( ( uOSBase_t ) 2U, ( uOSBase_t ) 0U );
+    gBenchSem = OSSemCreateCount( ( uOSBase_t ) 1U, ( uOSBase_t ) 0U );
+    if( ( gBenchDoneSem == OS_NULL ) || ( gBenchSem == OS_NULL ) )
+    {
+        return OS_FALSE;
+    }
+
+    if( OSTaskCreate( OSBenchTask, OS_NULL, OSBENCH_STACK_SIZE, OSBENCH_PRIO, ( sOS8_t * ) "bench" ) == OS_NULL )
+    {
+        return OS_FALSE;
+    }
+
+    return OS_TRUE;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,91 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#ifndef __OS_BENCH_H_
+#define __OS_BENCH_H_
+
+#include "OSType.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The timebase of the measurements, a board without the port cycle counter defines its own in OSPreset.h
+#ifndef OSBENCH_CYCLES
+  #define    OSBENCH_CYCLES()          OSGetCycleCount()
+#endif
+
+// Number of operations measured for each result
+#ifndef OSBENCH_LOOPS
+  #define    OSBENCH_LOOPS             ( 1000U )
+#endif
+
+// Priority of the task running the benchmarks, the tasks it creates run above it
+#ifndef OSBENCH_PRIO
+  #define    OSBENCH_PRIO              ( 1U )
+#endif
+
+// Turn of the CPU-bound tasks compared with a turn of 1 tick, in ticks
+#ifndef OSBENCH_SLICE_TICKS
+  #define    OSBENCH_SLICE_TICKS       ( 10U )
+#endif
+
+#ifndef OSBENCH_STACK_SIZE
+  #define    OSBENCH_STACK_SIZE        ( OSMINIMAL_STACK_SIZE * 4U )
+#endif
+
+// Longest line of the results passed to OSBenchOutput, including the terminator
+#define      OSBENCH_LINE_LEN          ( 80U )
+
+/* Supplied by the board: prints one line of the results, and is called
+once every benchmark has run. A failed check ends the run with
+OSBenchFail() instead of OSBenchDone(). */
+extern void  OSBenchOutput( const char * pcText );
+extern void  OSBenchDone( void );
+extern void  OSBenchFail( void );
+
+uOSBool_t    OSBenchCreate( void ) TINIUX_FUNCTION;
+
+/* Append text or a decimal number to a results line, return the new end. */
+char *       OSBenchAppend( char * pcTo, const char * pcText ) TINIUX_FUNCTION;
+char *       OSBenchAppendNum( char * pcTo, uOS32_t uiValue ) TINIUX_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__OS_BENCH_H_
@@ -0,0 +1,251 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+/* Wake latency under load: a periodic interrupt wakes two tasks with
+OSSemPostFromISR and OSTaskSignalEmitFromISR in turn, while lower priority
+tasks keep the kernel busy in its longest interrupt masked paths. The
+kernel latency trace measures each wakeup, the run prints min/avg/max and
+the percentiles and fails past OSBENCH_LATENCY_LIMIT. */
+
+#include "TINIUX.h"
+#include "OSBench.h"
+#include "OSBenchLatency.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( OS_LATENCY_TRACE_ON==0 ) || ( OS_SEMAPHORE_ON==0 ) || ( OS_TASK_SIGNAL_ON==0 ) || ( OS_MEMFREE_ON==0 )
+  #error "The latency bench needs SETOS_CYCLE_COUNTER_ON, SETOS_LATENCY_TRACE_ON, SETOS_USE_SEMAPHORE, SETOS_TASK_SIGNAL_ON and SETOS_ENABLE_MEMFREE"
+#endif
+
+#define OSBENCH_LATENCY_HEAP_BLOCKS ( 32U )
+#define OSBENCH_LATENCY_LOCK_LOOPS  ( 200U )
+
+/* The load runs below the sleeping tasks, the woken tasks run above both
+and the task collecting the results above all of them. */
+#define OSBENCH_LATENCY_LOAD_PRIO   ( OSBENCH_PRIO + 1U )
+#define OSBENCH_LATENCY_SLEEP_PRIO  ( OSBENCH_PRIO + 2U )
+#define OSBENCH_LATENCY_WAKE_PRIO   ( OSBENCH_PRIO + 3U )
+#define OSBENCH_LATENCY_MAIN_PRIO   ( OSBENCH_PRIO + 4U )
+
+TINIUX_DATA static OSSemHandle_t      gLatencySem               = OS_NULL;
+TINIUX_DATA static OSTaskHandle_t     gLatencySigTask           = OS_NULL;
+TINIUX_DATA static volatile uOS32_t   guiLatencyFired           = 0UL;
+TINIUX_DATA static uOSTick_t          guxLatencySleep[ OSBENCH_LATENCY_SLEEPERS ];
+
+static void OSBenchLatencyISR( void )
+{
+    if( guiLatencyFired < ( uOS32_t ) OSBENCH_LATENCY_SAMPLES )
+    {
+        if( ( guiLatencyFired & 1UL ) == 0UL )
+        {
+            ( void ) OSSemPostFromISR( gLatencySem );
+        }
+        else
+        {
+            ( void ) OSTaskSignalEmitFromISR( gLatencySigTask );
+        }
+        guiLatencyFired++;
+    }
+}
+
+static void OSBenchLatencySemTask( void * pvParameter )
+{
+    ( void ) pvParameter;
+
+    for( ;; )
+    {
+        ( void ) OSSemPend( gLatencySem, OSPEND_FOREVER_VALUE );
+    }
+}
+
+static void OSBenchLatencySigTask( void * pvParameter )
+{
+    ( void ) pvParameter;
+
+    for( ;; )
+    {
+        ( void ) OSTaskSignalWait( OSPEND_FOREVER_VALUE );
+    }
+}
+
+/* Frees and allocates blocks of changing sizes in a changing order, so the
+heap stays fragmented and every allocation walks the free list. */
+static void OSBenchLatencyHeapTask( void * pvParameter )
+{
+    void * apvBlock[ OSBENCH_LATENCY_HEAP_BLOCKS ];
+    uOS32_t uiRound = 0UL;
+    uOS32_t x = 0UL;
+
+    ( void ) pvParameter;
+
+    for( x = 0UL; x < OSBENCH_LATENCY_HEAP_BLOCKS; x++ )
+    {
+        apvBlock[ x ] = OS_NULL;
+    }
+
+    for( ;; )
+    {
+        x = uiRound % OSBENCH_LATENCY_HEAP_BLOCKS;
+        if( apvBlock[ x ] != OS_NULL )
+        {
+            OSMemFree( apvBlock[ x ] );
+        }
+        apvBlock[ x ] = OSMemMalloc( ( uOSMemSize_t ) ( 16UL + ( ( uiRound * 37UL ) % 200UL ) ) );
+        uiRound += 7UL;
+    }
+}
+
+/* Holds the scheduler locked while the interrupt fires, the woken tasks
+wait in the pending ready list until OSScheduleUnlock moves them. */
+static void OSBenchLatencyLockTask( void * pvParameter )
+{
+    volatile uOS32_t uiSpin = 0UL;
+
+    ( void ) pvParameter;
+
+    for( ;; )
+    {
+        OSScheduleLock();
+        for( uiSpin = 0UL; uiSpin < OSBENCH_LATENCY_LOCK_LOOPS; uiSpin++ )
+        {
+        }
+        ( void ) OSScheduleUnlock();
+    }
+}
+
+/* Tasks sleeping for different times, every sleep is inserted in order
+into the delayed list. */
+static void OSBenchLatencySleepTask( void * pvParameter )
+{
+    const uOSTick_t * const puxTicks = ( const uOSTick_t * ) pvParameter;
+
+    for( ;; )
+    {
+        OSTaskSleep( *puxTicks );
+    }
+}
+
+static void OSBenchLatencyTask( void * pvParameter )
+{
+    char cLine[ OSBENCH_LINE_LEN ];
+    char * pcTo = cLine;
+    tOSLatencyStats_t tStats;
+
+    ( void ) pvParameter;
+
+    OSTaskLatencyReset();
+    OSBenchTimerStart( OSBenchLatencyISR, ( uOS32_t ) OSBENCH_LATENCY_PERIOD );
+    while( guiLatencyFired < ( uOS32_t ) OSBENCH_LATENCY_SAMPLES )
+    {
+        OSTaskSleep( ( uOSTick_t ) 10U );
+    }
+    OSBenchTimerStart( OS_NULL, 0UL );
+
+    /* Let the last woken task run. */
+    OSTaskSleep( ( uOSTick_t ) 2U );
+    OSTaskLatencyGetStats( &tStats );
+
+    pcTo = OSBenchAppend( pcTo, "wake latency, " );
+    pcTo = OSBenchAppendNum( pcTo, tStats.uiCount );
+    pcTo = OSBenchAppend( pcTo, " wakeups: min " );
+    pcTo = OSBenchAppendNum( pcTo, tStats.uiMin );
+    pcTo = OSBenchAppend( pcTo, ", avg " );
+    pcTo = OSBenchAppendNum( pcTo, ( tStats.uiCount != 0UL ) ? ( tStats.uiSum / tStats.uiCount ) : 0UL );
+    pcTo = OSBenchAppend( pcTo, ", max " );
+    pcTo = OSBenchAppendNum( pcTo, tStats.uiMax );
+    ( void ) OSBenchAppend( pcTo, " cycles\n" );
+    OSBenchOutput( cLine );
+
+    pcTo = cLine;
+    pcTo = OSBenchAppend( pcTo, "wake latency, p50 <= " );
+    pcTo = OSBenchAppendNum( pcTo, OSTaskLatencyGetPercentile( ( uOSBase_t ) 50U ) );
+    pcTo = OSBenchAppend( pcTo, ", p99 <= " );
+    pcTo = OSBenchAppendNum( pcTo, OSTaskLatencyGetPercentile( ( uOSBase_t ) 99U ) );
+    ( void ) OSBenchAppend( pcTo, " cycles\n" );
+    OSBenchOutput( cLine );
+
+    /* Most wakeups have to be measured, and none may take a whole tick. */
+    if( ( tStats.uiCount < ( ( uOS32_t ) OSBENCH_LATENCY_SAMPLES / 2UL ) ) ||
+        ( tStats.uiMax > ( uOS32_t ) OSBENCH_LATENCY_LIMIT ) )
+    {
+        OSBenchOutput( "wake latency: FAILED\n" );
+        OSBenchFail();
+    }
+
+    OSBenchDone();
+
+    OSTaskSuspend( OS_NULL );
+}
+
+/* Call before OSStart, the results are printed by OSBenchOutput. */
+uOSBool_t OSBenchLatencyCreate( void )
+{
+    uOSBase_t x = ( uOSBase_t ) 0U;
+
+    gLatencySem = OSSemCreateCount( ( uOSBase_t ) 1U, ( uOSBase_t ) 0U );
+    if( gLatencySem == OS_NULL )
+    {
+        return OS_FALSE;
+    }
+
+    gLatencySigTask = OSTaskCreate( OSBenchLatencySigTask, OS_NULL, OSMINIMAL_STACK_SIZE * 2U, OSBENCH_LATENCY_WAKE_PRIO, ( sOS8_t * ) "sigwake" );
+    if( ( gLatencySigTask == OS_NULL ) ||
+        ( OSTaskCreate( OSBenchLatencySemTask, OS_NULL, OSMINIMAL_STACK_SIZE * 2U, OSBENCH_LATENCY_WAKE_PRIO, ( sOS8_t * ) "semwake" ) == OS_NULL ) ||
+        ( OSTaskCreate( OSBenchLatencyHeapTask, OS_NULL, OSBENCH_STACK_SIZE, OSBENCH_LATENCY_LOAD_PRIO, ( sOS8_t * ) "heap" ) == OS_NULL ) ||
+        ( OSTaskCreate( OSBenchLatencyLockTask, OS_NULL, OSMINIMAL_STACK_SIZE * 2U, OSBENCH_LATENCY_LOAD_PRIO, ( sOS8_t * ) "lock" ) == OS_NULL ) ||
+        ( OSTaskCreate( OSBenchLatencyTask, OS_NULL, OSBENCH_STACK_SIZE, OSBENCH_LATENCY_MAIN_PRIO, ( sOS8_t * ) "latency" ) == OS_NULL ) )
+    {
+        return OS_FALSE;
+    }
+
+    for( x = ( uOSBase_t ) 0U; x < ( uOSBase_t ) OSBENCH_LATENCY_SLEEPERS; x++ )
+    {
+        guxLatencySleep[ x ] = ( uOSTick_t ) ( 1U + ( ( x * 5U ) % 13U ) );
+        if( OSTaskCreate( OSBenchLatencySleepTask, ( void * ) &guxLatencySleep[ x ], OSMINIMAL_STACK_SIZE * 2U, OSBENCH_LATENCY_SLEEP_PRIO, ( sOS8_t * ) "sleep" ) == OS_NULL )
+        {
+            return OS_FALSE;
+        }
+    }
+
+    return OS_TRUE;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,77 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#ifndef __OS_BENCH_LATENCY_H_
+#define __OS_BENCH_LATENCY_H_
+
+#include "OSType.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Number of wakeups fired from the interrupt before the results are printed
+#ifndef OSBENCH_LATENCY_SAMPLES
+  #define    OSBENCH_LATENCY_SAMPLES   ( 2000U )
+#endif
+
+// Period of the waking interrupt in timer clocks, prime so it drifts against the tick
+#ifndef OSBENCH_LATENCY_PERIOD
+  #define    OSBENCH_LATENCY_PERIOD    ( 30011U )
+#endif
+
+// The run fails if a wakeup took longer than this many cycles, one tick by default
+#ifndef OSBENCH_LATENCY_LIMIT
+  #define    OSBENCH_LATENCY_LIMIT     ( OSCPU_CLOCK_HZ / OSTICK_RATE_HZ )
+#endif
+
+// Tasks sleeping for different times, each wakeup inserts into the sorted delayed list
+#ifndef OSBENCH_LATENCY_SLEEPERS
+  #define    OSBENCH_LATENCY_SLEEPERS  ( 12U )
+#endif
+
+/* Supplied by the board: calls pxHandler every uiPeriod timer clocks from
+an interrupt allowed to use the FromISR API, OS_NULL stops it. */
+extern void  OSBenchTimerStart( void ( * pxHandler )( void ), uOS32_t uiPeriod );
+
+uOSBool_t    OSBenchLatencyCreate( void ) TINIUX_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__OS_BENCH_LATENCY_H_
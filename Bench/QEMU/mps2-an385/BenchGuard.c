@@ -0,0 +1,123 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+/* Test of the port's MPU stack guard: a task recursing without end has to
+fault in the guard region, FitMemManageHandler has to pass that task to
+OSStackOverflowHook. QEMU exits with 0 only when the hook runs from the
+MemManage exception for the recursing task. */
+
+#include <stdint.h>
+
+#include "TINIUX.h"
+#include "OSBench.h"
+
+#if ( OS_MPU_STACK_GUARD_ON==0 ) || ( OS_STACK_OVERFLOW_HOOK_ON==0 )
+  #error "The stack guard test needs SETOS_MPU_STACK_GUARD_ON and SETOS_STACK_OVERFLOW_HOOK_ON"
+#endif
+
+#define BenchIPSR_MEMMANAGE             ( 4UL )
+#define BenchGUARD_MAX_DEPTH            ( 100000UL )
+
+static OSTaskHandle_t gBenchGuardTask = OS_NULL;
+static volatile uint32_t gulBenchGuardDepth = 0UL;
+
+static uint32_t BenchGuardRecurse( void )
+{
+    volatile uint32_t ulFrame[ 8 ];
+
+    ulFrame[ 0 ] = ++gulBenchGuardDepth;
+    if( ulFrame[ 0 ] > BenchGUARD_MAX_DEPTH )
+    {
+        return 0UL;
+    }
+
+    return BenchGuardRecurse() + ulFrame[ 0 ];
+}
+
+/* Sleeps first, so the guard region has been moved between the stacks by
+a few switches before the overflow. */
+static void BenchGuardTask( void * pvParameter )
+{
+    ( void ) pvParameter;
+
+    OSTaskSleep( ( uOSTick_t ) 5U );
+    ( void ) BenchGuardRecurse();
+
+    OSBenchOutput( "stack guard: FAILED, no fault\n" );
+    OSBenchFail();
+    OSTaskSuspend( OS_NULL );
+}
+
+static void BenchGuardSleepTask( void * pvParameter )
+{
+    ( void ) pvParameter;
+
+    for( ;; )
+    {
+        OSTaskSleep( ( uOSTick_t ) 1U );
+    }
+}
+
+void OSStackOverflowHook( OSTaskHandle_t TaskHandle, char * pcTaskName )
+{
+    uint32_t ulIPSR = 0UL;
+
+    __asm volatile( "mrs %0, ipsr" : "=r" ( ulIPSR ) );
+
+    if( ( ( ulIPSR & 0x1ffUL ) == BenchIPSR_MEMMANAGE ) && ( TaskHandle == gBenchGuardTask ) )
+    {
+        OSBenchOutput( "stack guard: MemManage fault in task " );
+        OSBenchOutput( pcTaskName );
+        OSBenchOutput( "\n" );
+        OSBenchDone();
+    }
+
+    OSBenchOutput( "stack guard: FAILED, hook called outside MemManage or for another task\n" );
+    OSBenchFail();
+}
+
+uOSBool_t BenchGuardCreate( void )
+{
+    gBenchGuardTask = OSTaskCreate( BenchGuardTask, OS_NULL, OSMINIMAL_STACK_SIZE * 2U, OSBENCH_PRIO + 1U, ( sOS8_t * ) "guard" );
+    if( ( gBenchGuardTask == OS_NULL ) ||
+        ( OSTaskCreate( BenchGuardSleepTask, OS_NULL, OSMINIMAL_STACK_SIZE * 2U, OSBENCH_PRIO, ( sOS8_t * ) "sleep" ) == OS_NULL ) )
+    {
+        return OS_FALSE;
+    }
+
+    return OS_TRUE;
+}
@@ -0,0 +1,256 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+/* Board of the benchmarks on the QEMU mps2-an385 machine (Cortex-M3), the
+results are printed over semihosting and QEMU exits once they are done.
+The mps2-an500 (Cortex-M7) build uses it as well, both machines have the
+same SysTick, timers and clock. */
+
+#include <stdint.h>
+
+#include "TINIUX.h"
+#include "OSBench.h"
+#include "OSBenchLatency.h"
+
+#define BenchSYSTICK_LOAD_REG           ( * ( ( volatile uint32_t * ) 0xe000e014 ) )
+#define BenchSYSTICK_CURRENT_VALUE_REG  ( * ( ( volatile uint32_t * ) 0xe000e018 ) )
+#define BenchNVIC_INT_CTRL_REG          ( * ( ( volatile uint32_t * ) 0xe000ed04 ) )
+#define BenchNVIC_PENDSTSET_BIT         ( 1UL << 26UL )
+#define BenchNVIC_ISER0_REG             ( * ( ( volatile uint32_t * ) 0xe000e100 ) )
+#define BenchNVIC_IPR_REG( x )          ( * ( ( volatile uint8_t * ) ( 0xe000e400 + ( x ) ) ) )
+
+/* CMSDK APB timer 0, clocked by the system clock. */
+#define BenchTIMER0_IRQ                 ( 8UL )
+#define BenchTIMER0_CTRL_REG            ( * ( ( volatile uint32_t * ) 0x40000000 ) )
+#define BenchTIMER0_VALUE_REG           ( * ( ( volatile uint32_t * ) 0x40000004 ) )
+#define BenchTIMER0_RELOAD_REG          ( * ( ( volatile uint32_t * ) 0x40000008 ) )
+#define BenchTIMER0_INTCLEAR_REG        ( * ( ( volatile uint32_t * ) 0x4000000c ) )
+#define BenchTIMER0_CTRL_ENABLE         ( 1UL << 0UL )
+#define BenchTIMER0_CTRL_IRQ_ENABLE     ( 1UL << 3UL )
+
+#define BenchSEMIHOST_SYS_WRITE0        ( 0x04UL )
+#define BenchSEMIHOST_SYS_EXIT          ( 0x18UL )
+#define BenchSEMIHOST_APP_EXIT          ( 0x20026UL )
+#define BenchSEMIHOST_RUNTIME_ERROR     ( 0x20023UL )
+
+/* The mps2-an385 system clock. */
+uint32_t SystemCoreClock = 25000000UL;
+
+extern uint32_t _sidata, _sdata, _edata, _sbss, _ebss, _estack;
+
+extern void SVC_Handler( void );
+extern void PendSV_Handler( void );
+extern void SysTick_Handler( void );
+
+void Reset_Handler( void );
+static void BenchDefaultHandler( void );
+static void BenchSysTickHandler( void );
+static void BenchTimer0Handler( void );
+#ifdef OSBENCH_GUARD
+extern uOSBool_t BenchGuardCreate( void );
+#endif
+
+/* SysTick periods since the scheduler started, counted here because the
+kernel tick stands still while the scheduler is locked. */
+static volatile uint32_t gulBenchSysTickWraps = 0UL;
+
+static void ( * volatile gpxBenchTimerHandler )( void ) = 0;
+
+__attribute__ (( section( ".isr_vector" ), used ))
+void ( * const gpxBenchVectors[] )( void ) =
+{
+    ( void ( * )( void ) ) &_estack,
+    Reset_Handler,
+    BenchDefaultHandler,                /* NMI */
+    BenchDefaultHandler,                /* HardFault */
+#if ( OS_MPU_STACK_GUARD_ON!=0 )
+    FitMemManageHandler,
+#else
+    BenchDefaultHandler,                /* MemManage */
+#endif //( OS_MPU_STACK_GUARD_ON!=0 )
+    BenchDefaultHandler,                /* BusFault */
+    BenchDefaultHandler,                /* UsageFault */
+    0, 0, 0, 0,
+    SVC_Handler,
+    BenchDefaultHandler,                /* DebugMon */
+    0,
+    PendSV_Handler,
+    BenchSysTickHandler,
+    BenchDefaultHandler,                /* IRQ0 UART0 RX */
+    BenchDefaultHandler,                /* IRQ1 UART0 TX */
+    BenchDefaultHandler,                /* IRQ2 UART1 RX */
+    BenchDefaultHandler,                /* IRQ3 UART1 TX */
+    BenchDefaultHandler,                /* IRQ4 UART2 RX */
+    BenchDefaultHandler,                /* IRQ5 UART2 TX */
+    BenchDefaultHandler,                /* IRQ6 GPIO0 */
+    BenchDefaultHandler,                /* IRQ7 GPIO1 */
+    BenchTimer0Handler                  /* IRQ8 TIMER0 */
+};
+
+static uint32_t BenchSemihost( uint32_t ulOperation, const void * pvArgument )
+{
+    register uint32_t r0 __asm( "r0" ) = ulOperation;
+    register const void * r1 __asm( "r1" ) = pvArgument;
+
+    __asm volatile( "bkpt 0xab" : "+r" ( r0 ) : "r" ( r1 ) : "memory" );
+
+    return r0;
+}
+
+static void BenchDefaultHandler( void )
+{
+    BenchSemihost( BenchSEMIHOST_SYS_WRITE0, "bench: unexpected exception\n" );
+    OSBenchFail();
+    for( ;; )
+    {
+    }
+}
+
+static void BenchSysTickHandler( void )
+{
+    gulBenchSysTickWraps++;
+    SysTick_Handler();
+}
+
+static void BenchTimer0Handler( void )
+{
+    void ( * pxHandler )( void ) = gpxBenchTimerHandler;
+
+    BenchTIMER0_INTCLEAR_REG = 1UL;
+    if( pxHandler != 0 )
+    {
+        pxHandler();
+    }
+}
+
+/* SysTick clocks since the scheduler started, the port cycle counter
+works the same way on Cortex-M0. */
+uint32_t BenchBoardCycles( void )
+{
+    uint32_t ulTicks = 0UL;
+    uint32_t ulCount = 0UL;
+    uint32_t ulReload = BenchSYSTICK_LOAD_REG + 1UL;
+    uint32_t ulPreviousMask = 0UL;
+
+    ulPreviousMask = FitIntMaskFromISR();
+    {
+        ulTicks = gulBenchSysTickWraps;
+        ulCount = BenchSYSTICK_CURRENT_VALUE_REG;
+        if( ( BenchNVIC_INT_CTRL_REG & BenchNVIC_PENDSTSET_BIT ) != 0UL )
+        {
+            ulCount = BenchSYSTICK_CURRENT_VALUE_REG;
+            ulTicks++;
+        }
+    }
+    FitIntUnmaskFromISR( ulPreviousMask );
+
+    return ( ulTicks * ulReload ) + ( ulReload - 1UL - ulCount );
+}
+
+void OSBenchOutput( const char * pcText )
+{
+    ( void ) BenchSemihost( BenchSEMIHOST_SYS_WRITE0, pcText );
+}
+
+void OSBenchDone( void )
+{
+    ( void ) BenchSemihost( BenchSEMIHOST_SYS_EXIT, ( const void * ) BenchSEMIHOST_APP_EXIT );
+}
+
+/* The timer interrupt runs at the highest priority allowed to use the
+FromISR API, so kernel critical sections delay it. */
+void OSBenchTimerStart( void ( * pxHandler )( void ), uOS32_t uiPeriod )
+{
+    BenchTIMER0_CTRL_REG = 0UL;
+    gpxBenchTimerHandler = pxHandler;
+    if( pxHandler != 0 )
+    {
+        BenchNVIC_IPR_REG( BenchTIMER0_IRQ ) = ( uint8_t ) OSMAX_HWINT_PRI;
+        BenchNVIC_ISER0_REG = ( 1UL << BenchTIMER0_IRQ );
+        BenchTIMER0_RELOAD_REG = uiPeriod;
+        BenchTIMER0_VALUE_REG = uiPeriod;
+        BenchTIMER0_CTRL_REG = BenchTIMER0_CTRL_ENABLE | BenchTIMER0_CTRL_IRQ_ENABLE;
+    }
+}
+
+/* Ends QEMU with a non-zero exit status. */
+void OSBenchFail( void )
+{
+    ( void ) BenchSemihost( BenchSEMIHOST_SYS_EXIT, ( const void * ) BenchSEMIHOST_RUNTIME_ERROR );
+}
+
+int main( void )
+{
+    ( void ) OSInit();
+
+#if defined( OSBENCH_LATENCY )
+    if( OSBenchLatencyCreate() == OS_FALSE )
+#elif defined( OSBENCH_GUARD )
+    if( BenchGuardCreate() == OS_FALSE )
+#else
+    if( OSBenchCreate() == OS_FALSE )
+#endif
+    {
+        OSBenchOutput( "bench: out of memory\n" );
+        OSBenchDone();
+    }
+
+    ( void ) OSStart();
+
+    return 0;
+}
+
+void Reset_Handler( void )
+{
+    uint32_t * pulFrom = &_sidata;
+    uint32_t * pulTo = &_sdata;
+
+    while( pulTo < &_edata )
+    {
+        *pulTo++ = *pulFrom++;
+    }
+    for( pulTo = &_sbss; pulTo < &_ebss; pulTo++ )
+    {
+        *pulTo = 0UL;
+    }
+
+    ( void ) main();
+
+    for( ;; )
+    {
+    }
+}
@@ -53,6 +53,7 @@ extern "C" {
 #define FitNVIC_SYSTICK_INT             0x00000002
 #define FitNVIC_SYSTICK_ENABLE          0x00000001
 #define FitNVIC_PENDSVSET               0x10000000
+#define FitNVIC_PENDSTSET               0x04000000
 #define FitNVIC_PENDSV_PRI              ( ( ( uOS32_t ) OSMIN_HWINT_PRI ) << 16UL )
 #define FitNVIC_SYSTICK_PRI             ( ( ( uOS32_t ) OSMIN_HWINT_PRI ) << 24UL )
 
@@ -76,6 +77,12 @@ extern "C" {
 variable. */
 static volatile uOSBase_t guxIntLocked = 0xaaaaaaaa;
 
+#if ( OS_CYCLE_COUNTER_ON!=0 )
+/* SysTick periods since the timer was started. The kernel tick can not be
+used, it stands still while the scheduler is locked. */
+static volatile uOS32_t gulFitSysTickWraps = 0UL;
+#endif //( OS_CYCLE_COUNTER_ON!=0 )
+
 /*
  * Setup the timer to generate the tick interrupts.
  */
@@ -175,6 +182,10 @@ sOSBase_t FitStartScheduler( void )
     /* Initialise the lock nesting count ready for the first task. */
     guxIntLocked = 0;
 
+    #if ( OS_CYCLE_COUNTER_ON!=0 )
+    FitCycleCounterInit();
+    #endif //( OS_CYCLE_COUNTER_ON!=0 )
+
     /* Start the first task. */
     FitStartFirstTask();
 
@@ -301,6 +312,10 @@ void FitOSTickISR( void )
 
     ulPreviousMask = FitIntMaskFromISR();
     {
+        #if ( OS_CYCLE_COUNTER_ON!=0 )
+        gulFitSysTickWraps++;
+        #endif //( OS_CYCLE_COUNTER_ON!=0 )
+
         /* Increment the RTOS tick. */
         if( OSIncrementTickCount() != OS_FALSE )
         {
@@ -329,6 +344,36 @@ void FitSetupTimerInterrupt( void )
 /*-----------------------------------------------------------*/
 
 
+#if ( OS_CYCLE_COUNTER_ON!=0 )
+uOS32_t FitGetCycleCount( void )
+{
+    uOS32_t ulTicks = 0UL;
+    uOS32_t ulCount = 0UL;
+    uOS32_t ulReload = *(FitNVIC_SYSTICK_LOAD) + 1UL;
+    uOS32_t ulPreviousMask;
+
+    /* Use the raw mask, the profiled one reads this counter. The wrap
+    count can not change while the interrupts are masked. */
+    ulPreviousMask = FitIntMaskFromISR();
+    {
+        ulTicks = gulFitSysTickWraps;
+        ulCount = *(FitNVIC_SYSTICK_CURRENT_VALUE);
+
+        /* The SysTick wrapped but its tick is not counted yet, read the
+        value again as it may have wrapped after the first read. */
+        if( ( *(FitNVIC_INT_CTRL) & FitNVIC_PENDSTSET ) != 0UL )
+        {
+            ulCount = *(FitNVIC_SYSTICK_CURRENT_VALUE);
+            ulTicks++;
+        }
+    }
+    FitIntUnmaskFromISR( ulPreviousMask );
+
+    /* SysTick counts down from the reload value. */
+    return ( ulTicks * ulReload ) + ( ulReload - 1UL - ulCount );
+}
+#endif //( OS_CYCLE_COUNTER_ON!=0 )
+
 #ifdef __cplusplus
 }
 #endif
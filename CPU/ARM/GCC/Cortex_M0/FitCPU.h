@@ -86,6 +86,25 @@ void FitPendSVHandler( void ) __attribute__ (( naked ));
 void FitOSTickISR( void );
 void FitSVCHandler( void ) __attribute__ (( naked ));
 
+#if ( OS_CYCLE_COUNTER_ON!=0 )
+/* Cortex-M0 has no cycle counter, SysTick counts are used instead. */
+#define FitCycleCounterInit()
+uOS32_t FitGetCycleCount( void );
+#endif //( OS_CYCLE_COUNTER_ON!=0 )
+
+#if ( OS_INT_PROFILE_ON!=0 )
+/* Return address of the current function, read it before any other call. */
+#define FitGetReturnAddress()       __builtin_return_address( 0 )
+#endif //( OS_INT_PROFILE_ON!=0 )
+
+#if ( OS_MPU_STACK_GUARD_ON!=0 )
+  #error "SETOS_MPU_STACK_GUARD_ON is not supported by this port, it has no MPU stack guard"
+#endif //( OS_MPU_STACK_GUARD_ON!=0 )
+
+#if ( OS_TCM_PLACEMENT_ON!=0 )
+  #error "SETOS_TCM_PLACEMENT_ON is not supported by this port, it has no FitTCM linker fragment"
+#endif //( OS_TCM_PLACEMENT_ON!=0 )
+
 #ifdef __cplusplus
 }
 #endif
@@ -58,6 +58,11 @@ typedef        uOS32_t             uOSTick_t;
 #define        FITSTACK_GROWTH     ( -1 )
 #define        FITBYTE_ALIGNMENT   ( 8 )
 
+/* Section for the kernel switch and tick path code, run from RAM, see FitTCM.ld.
+The data stays in SRAM, which has no wait states. */
+#define        FitTCM_FUNCTION     __attribute__(( section( ".ramfunc" ) ))
+#define        FitTCM_DATA
+
 
 #ifdef __cplusplus
 }
@@ -163,6 +163,15 @@ sOSBase_t FitStartScheduler( void )
     /* Initialise the lock nesting count ready for the first task. */
     guxIntLocked = 0;
 
+    #if ( OS_MPU_STACK_GUARD_ON!=0 )
+    /* Guard the bottom of the first task's stack. */
+    FitMPUSetup();
+    #endif //( OS_MPU_STACK_GUARD_ON!=0 )
+
+    #if ( OS_CYCLE_COUNTER_ON!=0 )
+    FitCycleCounterInit();
+    #endif //( OS_CYCLE_COUNTER_ON!=0 )
+
     /* Start the first task. */
     FitStartFirstTask();
 
@@ -387,6 +396,62 @@ __weak void FitSetupTimerInterrupt( void )
     FitNVIC_SYSTICK_CTRL_REG = ( FitNVIC_SYSTICK_CLK_BIT | FitNVIC_SYSTICK_INT_BIT | FitNVIC_SYSTICK_ENABLE_BIT );
 }
 
+#if ( OS_MPU_STACK_GUARD_ON!=0 )
+#define FitMPU_CTRL_REG                     ( * ( ( volatile uOS32_t * ) 0xe000ed94 ) )
+#define FitMPU_RNR_REG                      ( * ( ( volatile uOS32_t * ) 0xe000ed98 ) )
+#define FitMPU_RASR_REG                     ( * ( ( volatile uOS32_t * ) 0xe000eda0 ) )
+#define FitSHCSR_REG                        ( * ( ( volatile uOS32_t * ) 0xe000ed24 ) )
+#define FitMPU_CTRL_ENABLE_BIT              ( 1UL << 0UL )
+#define FitMPU_CTRL_PRIVDEFENA_BIT          ( 1UL << 2UL )
+#define FitMPU_RASR_ENABLE_BIT              ( 1UL << 0UL )
+#define FitMPU_RASR_SIZE_32B                ( 4UL << 1UL )
+#define FitMPU_RASR_XN_BIT                  ( 1UL << 28UL )
+#define FitSHCSR_MEMFAULTENA_BIT            ( 1UL << 16UL )
+
+extern tOSTCB_t * volatile gptCurrentTCB;
+
+void FitMPUSetup( void )
+{
+    /* The guard region: 32 bytes, no access at all, never executable. */
+    FitMPU_RNR_REG = FitMPU_GUARD_REGION;
+    FitMPUStackGuard( gptCurrentTCB->puxStartStack );
+    FitMPU_RASR_REG = ( FitMPU_RASR_XN_BIT | FitMPU_RASR_SIZE_32B | FitMPU_RASR_ENABLE_BIT );
+
+    /* Other memory keeps the default map for privileged code. */
+    FitMPU_CTRL_REG = ( FitMPU_CTRL_PRIVDEFENA_BIT | FitMPU_CTRL_ENABLE_BIT );
+    FitSHCSR_REG |= FitSHCSR_MEMFAULTENA_BIT;
+
+    __DSB();
+    __ISB();
+}
+
+void FitMemManageHandler( void )
+{
+    /* The running task has reached the guard region at the bottom of its
+    stack, gptCurrentTCB is the offending task. */
+    #if ( OS_STACK_OVERFLOW_HOOK_ON!=0 )
+    OSStackOverflowHook( gptCurrentTCB, gptCurrentTCB->pcTaskName );
+    #endif //( OS_STACK_OVERFLOW_HOOK_ON!=0 )
+
+    for( ;; );
+}
+#endif //( OS_MPU_STACK_GUARD_ON!=0 )
+
+#if ( OS_CYCLE_COUNTER_ON!=0 ) && defined( FitDWT_CYCCNT_REG )
+#define FitDEMCR_REG                        ( * ( ( volatile uOS32_t * ) 0xe000edfc ) )
+#define FitDWT_CTRL_REG                     ( * ( ( volatile uOS32_t * ) 0xe0001000 ) )
+#define FitDEMCR_TRCENA_BIT                 ( 1UL << 24UL )
+#define FitDWT_CTRL_CYCCNTENA_BIT           ( 1UL << 0UL )
+
+void FitCycleCounterInit( void )
+{
+    /* Enable the trace block, then start the cycle counter. */
+    FitDEMCR_REG |= FitDEMCR_TRCENA_BIT;
+    FitDWT_CYCCNT_REG = 0UL;
+    FitDWT_CTRL_REG |= FitDWT_CTRL_CYCCNTENA_BIT;
+}
+#endif //( OS_CYCLE_COUNTER_ON!=0 ) && defined( FitDWT_CYCCNT_REG )
+
 #ifdef __cplusplus
 }
 #endif
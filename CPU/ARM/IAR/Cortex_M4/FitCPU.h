@@ -99,6 +99,47 @@ void FitSVCHandler( void );
     #endif
 #endif
 
+#if ( OS_MPU_STACK_GUARD_ON!=0 )
+/* MPU region used as a no access guard at the bottom of the running task's stack. */
+#define FitMPU_RBAR_REG             ( * ( ( volatile uOS32_t * ) 0xe000ed9c ) )
+#define FitMPU_RBAR_VALID_BIT       ( 1UL << 4UL )
+#define FitMPU_GUARD_REGION         ( 7UL )
+#define FitMPU_GUARD_SIZE           ( 32UL )
+
+/* The guard is the first 32 bytes aligned block inside the stack. */
+#define FitMPUStackGuardBase( puxStartStack )   ( ( ( uOS32_t ) ( puxStartStack ) + FitMPU_GUARD_SIZE - 1UL ) & ~( FitMPU_GUARD_SIZE - 1UL ) )
+#define FitMPUStackGuardEnd( puxStartStack )    ( ( uOSStack_t * ) ( FitMPUStackGuardBase( puxStartStack ) + FitMPU_GUARD_SIZE ) )
+
+/* Move the guard region to another stack, RBAR selects the region itself. */
+#define FitMPUStackGuard( puxStartStack )       FitMPU_RBAR_REG = ( FitMPUStackGuardBase( puxStartStack ) | FitMPU_RBAR_VALID_BIT | FitMPU_GUARD_REGION )
+
+void FitMPUSetup( void );
+void FitMemManageHandler( void );
+#endif //( OS_MPU_STACK_GUARD_ON!=0 )
+
+#if ( OS_CYCLE_COUNTER_ON!=0 )
+#ifndef FitGetCycleCount
+/* The DWT cycle counter, a free running 32 bits count of core clocks. */
+#define FitDWT_CYCCNT_REG           ( * ( ( volatile uOS32_t * ) 0xe0001004 ) )
+#define FitGetCycleCount()          ( FitDWT_CYCCNT_REG )
+void FitCycleCounterInit( void );
+#else
+/* The board supplies the counter in OSPreset.h, e.g. a simulator without
+the DWT. */
+#define FitCycleCounterInit()
+#endif //FitGetCycleCount
+#endif //( OS_CYCLE_COUNTER_ON!=0 )
+
+#if ( OS_INT_PROFILE_ON!=0 )
+/* Return address of the current function, read it before any other call. */
+#define FitGetReturnAddress()       ( ( void * ) __get_LR() )
+#endif //( OS_INT_PROFILE_ON!=0 )
+
+#if ( OS_TCM_PLACEMENT_ON!=0 )
+/* The fast sections are copied by the startup code, see FitTCM.icf. */
+#define FitTCMInit()
+#endif //( OS_TCM_PLACEMENT_ON!=0 )
+
 #ifdef __cplusplus
 }
 #endif
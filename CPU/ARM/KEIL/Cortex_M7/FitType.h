@@ -58,6 +58,10 @@ typedef        uOS32_t             uOSTick_t;
 #define        FITSTACK_GROWTH     ( -1 )
 #define        FITBYTE_ALIGNMENT   ( 8 )
 
+/* Sections for the kernel switch and tick path, placed in the ITCM and DTCM, see FitTCM.sct. */
+#define        FitTCM_FUNCTION     __attribute__(( section( ".itcm_text" ) ))
+#define        FitTCM_DATA         __attribute__(( section( ".dtcm_data" ) ))
+
 #ifdef __cplusplus
 }
 #endif
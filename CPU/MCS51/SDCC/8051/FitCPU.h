@@ -85,10 +85,39 @@ void FitSchedule( void ) __naked;
 
 /*-----------------------------------------------------------*/
 
+/* RAM stack slices. A task given a slice with FitIRamStackAssign() keeps its
+stack in internal RAM, so its stack is never copied to or from XRAM on a
+context switch. A slice holds the deepest stack of the task, including the
+kernel calls and interrupts it runs. A task with a slice must not be deleted. */
+#ifndef FITIRAM_SLICE_NUM
+  #define    FITIRAM_SLICE_NUM          ( 0 )
+#endif
+#ifndef FITIRAM_SLICE_SIZE
+  #define    FITIRAM_SLICE_SIZE         ( OSMINIMAL_STACK_SIZE )
+#endif
+
+#if ( FITIRAM_SLICE_NUM > 0 )
+uOSBool_t FitIRamStackAssign( void * pvTaskHandle );
+#endif
+
 uOSStack_t *FitInitializeStack( uOSStack_t *pxTopOfStack, OSTaskFunction_t TaskFunction, void *pvParameters );
 sOSBase_t FitStartScheduler( void );
 void FitOSTickISR( void ) __interrupt 1 __naked;
 
+#if ( OS_CYCLE_COUNTER_ON!=0 )
+  /* The latency trace, boot and interrupt profiling all depend on it, the
+  interrupt profiling needs FitGetReturnAddress as well. */
+  #error "SETOS_CYCLE_COUNTER_ON is not supported by this port, it has no FitGetCycleCount or FitGetReturnAddress"
+#endif //( OS_CYCLE_COUNTER_ON!=0 )
+
+#if ( OS_MPU_STACK_GUARD_ON!=0 )
+  #error "SETOS_MPU_STACK_GUARD_ON is not supported by this port, it has no MPU stack guard"
+#endif //( OS_MPU_STACK_GUARD_ON!=0 )
+
+#if ( OS_TCM_PLACEMENT_ON!=0 )
+  #error "SETOS_TCM_PLACEMENT_ON is not supported by this port, it has no FitTCM linker fragment"
+#endif //( OS_TCM_PLACEMENT_ON!=0 )
+
 #ifdef __cplusplus
 }
 #endif
@@ -73,7 +73,11 @@ an XRAM byte is to be copied. */
 __idata static uOSStack_t * __idata     pxRAMStack = OS_NULL;
 
 /* We require the address of the gptCurrentTCB variable. */
-extern volatile tOSTCB_t * volatile     gptCurrentTCB;
+extern tOSTCB_t * volatile              gptCurrentTCB;
+
+/* Used during a context switch to remember the task being switched out, its
+stack is only moved out of the RAM stack if another task is switched in. */
+__idata static volatile tOSTCB_t *      pxFitPrevTCB = OS_NULL;
 
 /* Define the stack size which used by tiniux runing. */
 #ifndef OSRUNING_STACK_SIZE
@@ -84,24 +88,41 @@ extern volatile tOSTCB_t * volatile     gptCurrentTCB;
 __idata static uOSStack_t               gOSRuningRAMStack[OSRUNING_STACK_SIZE];
 __idata static const uOSStack_t         guxStackStartAddr = ( __idata uOSStack_t )  gOSRuningRAMStack ;
 
+#if ( FITIRAM_SLICE_NUM > 0 )
+/* The RAM stack slices, the tasks owning them and their saved stack pointer. */
+__idata static uOSStack_t               gFitIRamSlice[FITIRAM_SLICE_NUM][FITIRAM_SLICE_SIZE];
+__idata static uOS8_t                   gucFitIRamSP[FITIRAM_SLICE_NUM];
+__idata static void *                   gpvFitIRamTCB[FITIRAM_SLICE_NUM];
+
+/* Used during a context switch to hold the slice of a task. */
+__idata static uOS8_t                   ucSlice = 0U;
+#endif //( FITIRAM_SLICE_NUM > 0 )
+
 /*
  * Setup the hardware to generate an interrupt off timer 2 at the required
  * frequency.
  */
 static void FitSetupTimerInterrupt( void );
 
+#if ( FITIRAM_SLICE_NUM > 0 )
+/*
+ * Returns the RAM stack slice of a task, FITIRAM_SLICE_NUM if it has none.
+ */
+static uOS8_t FitIRamSliceOf( void * pvTCB );
+#endif //( FITIRAM_SLICE_NUM > 0 )
+
 /*-----------------------------------------------------------*/
 /*
  * Macro that copies the current stack from internal RAM to XRAM.  This is
  * required as the 8051 only contains enough internal RAM for a single stack,
  * but we have a stack for every task.
  */
-#define FitCopyStackToXRam()                                                                    \
+#define FitCopyStackToXRam( pxTCB )                                                             \
 {                                                                                               \
-    /* gptCurrentTCB points to a TCB which itself points to the location into                   \
+    /* pxTCB points to a TCB which itself points to the location into                           \
     which the first    stack byte should be copied.  Set pxXRAMStack to point                   \
     to the location into which the first stack byte is to be copied. */                         \
-    pxXRAMStack = ( __xdata uOSStack_t * ) *( ( __xdata uOSStack_t ** ) gptCurrentTCB );        \
+    pxXRAMStack = ( __xdata uOSStack_t * ) *( ( __xdata uOSStack_t ** ) ( pxTCB ) );            \
                                                                                                 \
     /* Set pxRAMStack to point to the first byte to be coped from the stack. */                 \
     pxRAMStack = ( __idata uOSStack_t * __idata ) guxStackStartAddr;                            \
@@ -155,6 +176,56 @@ static void FitSetupTimerInterrupt( void );
 }
 /*-----------------------------------------------------------*/
 
+#if ( FITIRAM_SLICE_NUM > 0 )
+/*
+ * Macros that move the stack of a task out of and back into the RAM stack,
+ * a task with a RAM stack slice only saves and restores the stack pointer.
+ */
+#define FitStackOut( pxTCB )                                                                    \
+{                                                                                               \
+    ucSlice = FitIRamSliceOf( ( void * ) ( pxTCB ) );                                           \
+    if( ucSlice < FITIRAM_SLICE_NUM )                                                           \
+    {                                                                                           \
+        gucFitIRamSP[ ucSlice ] = SP;                                                           \
+    }                                                                                           \
+    else                                                                                        \
+    {                                                                                           \
+        FitCopyStackToXRam( pxTCB );                                                            \
+    }                                                                                           \
+}
+
+#define FitStackIn()                                                                            \
+{                                                                                               \
+    ucSlice = FitIRamSliceOf( ( void * ) gptCurrentTCB );                                       \
+    if( ucSlice < FITIRAM_SLICE_NUM )                                                           \
+    {                                                                                           \
+        SP = gucFitIRamSP[ ucSlice ];                                                           \
+    }                                                                                           \
+    else                                                                                        \
+    {                                                                                           \
+        FitCopyXRamToStack();                                                                   \
+    }                                                                                           \
+}
+#else
+#define FitStackOut( pxTCB )            FitCopyStackToXRam( pxTCB )
+#define FitStackIn()                    FitCopyXRamToStack()
+#endif //( FITIRAM_SLICE_NUM > 0 )
+/*-----------------------------------------------------------*/
+
+/*
+ * Macro that moves the stacks once the task to run is known, nothing is
+ * copied if the running task keeps running.
+ */
+#define FitSwitchStack()                                                                        \
+{                                                                                               \
+    if( gptCurrentTCB != pxFitPrevTCB )                                                         \
+    {                                                                                           \
+        FitStackOut( pxFitPrevTCB );                                                            \
+        FitStackIn();                                                                           \
+    }                                                                                           \
+}
+/*-----------------------------------------------------------*/
+
 /*
  * Macro to push the current execution context onto the stack, before the stack
  * is moved to XRAM.
@@ -301,6 +372,62 @@ uOSStack_t *FitInitializeStack( uOSStack_t *pxTopOfStack, OSTaskFunction_t TaskF
 }
 /*-----------------------------------------------------------*/
 
+#if ( FITIRAM_SLICE_NUM > 0 )
+static uOS8_t FitIRamSliceOf( void * pvTCB )
+{
+    uOS8_t ucIndex;
+
+    for( ucIndex = 0U; ucIndex < FITIRAM_SLICE_NUM; ucIndex++ )
+    {
+        if( gpvFitIRamTCB[ ucIndex ] == pvTCB )
+        {
+            break;
+        }
+    }
+
+    return ucIndex;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * See header file for description.
+ */
+uOSBool_t FitIRamStackAssign( void * pvTaskHandle )
+{
+    __xdata uOSStack_t * pxStack;
+    uOS8_t ucIndex;
+    uOS8_t ucBytes;
+    uOSBool_t bReturn = OS_FALSE;
+
+    FitIntLock();
+    {
+        /* The stack of a task not running is complete in XRAM. */
+        if( ( pvTaskHandle != OS_NULL ) &&
+            ( ( pvTaskHandle != ( void * ) gptCurrentTCB ) || ( OSScheduleGetState() == SCHEDULER_NOT_STARTED ) ) &&
+            ( FitIRamSliceOf( pvTaskHandle ) == FITIRAM_SLICE_NUM ) )
+        {
+            ucIndex = FitIRamSliceOf( OS_NULL );
+            pxStack = *( ( __xdata uOSStack_t ** ) pvTaskHandle );
+            ucBytes = pxStack[ 0 ];
+
+            /* A saved stack holds at least the task context, an empty one
+            would put SP below the slice. */
+            if( ( ucIndex < FITIRAM_SLICE_NUM ) && ( ucBytes > ( uOS8_t ) 0U ) && ( ucBytes <= FITIRAM_SLICE_SIZE ) )
+            {
+                memcpy( gFitIRamSlice[ ucIndex ], &pxStack[ 1 ], ucBytes );
+                gucFitIRamSP[ ucIndex ] = ( uOS8_t ) &gFitIRamSlice[ ucIndex ][ ucBytes - 1 ];
+                gpvFitIRamTCB[ ucIndex ] = pvTaskHandle;
+                bReturn = OS_TRUE;
+            }
+        }
+    }
+    FitIntUnlock();
+
+    return bReturn;
+}
+/*-----------------------------------------------------------*/
+#endif //( FITIRAM_SLICE_NUM > 0 )
+
 /*
  * See header file for description.
  */
@@ -318,7 +445,7 @@ sOSBase_t FitStartScheduler( void )
 
     /* Copy the stack for the first task to execute from XRAM into the stack,
     restore the task context from the new stack, then start running the task. */
-    FitCopyXRamToStack();
+    FitStackIn();
     FitRestoreTaskContext();
 
     /* Should never get here! */
@@ -338,21 +465,18 @@ void FitEndScheduler( void )
  */
 void FitSchedule( void ) __naked
 {
-    /* Save the execution context onto the stack, then copy the entire stack
-    to XRAM.  This is necessary as the internal RAM is only large enough to
-    hold one stack, and we want one per task.
-
-    PERFORMANCE COULD BE IMPROVED BY ONLY COPYING TO XRAM IF A TASK SWITCH
-    IS REQUIRED. */
+    /* Save the execution context onto the stack.  The internal RAM is only
+    large enough to hold one stack, so the stack is copied to XRAM, but only
+    if another task is switched in. */
     FitSaveTaskContex();
-    FitCopyStackToXRam();
+    pxFitPrevTCB = gptCurrentTCB;
 
     /* Call the standard scheduler context switch function. */
     OSTaskSwitchContext();
 
-    /* Copy the stack of the task about to execute from XRAM into RAM and
-    restore it's context ready to run on exiting. */
-    FitCopyXRamToStack();
+    /* Move the stacks if the task changed and restore the context of the
+    task about to execute. */
+    FitSwitchStack();
     FitRestoreTaskContext();
 }
 /*-----------------------------------------------------------*/
@@ -364,7 +488,7 @@ void FitOSTickISR( void ) __interrupt 5 __naked
     of incrementing the RTOS tick count. */
 
     FitSaveTaskContex();
-    FitCopyStackToXRam();
+    pxFitPrevTCB = gptCurrentTCB;
 
     if( OSIncrementTickCount() != OS_FALSE )
     {
@@ -372,7 +496,7 @@ void FitOSTickISR( void ) __interrupt 5 __naked
     }
 
     FIT_CLEAR_INTERRUPT_FLAG();
-    FitCopyXRamToStack();
+    FitSwitchStack();
     FitRestoreTaskContext();
 }
 
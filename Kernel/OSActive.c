@@ -0,0 +1,625 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#include "TINIUX.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( OS_ACTIVE_ON!=0 )
+
+typedef struct tOSEventPool
+{
+    void *                   pvFreeList;                 /*< Free blocks, each holds the next free block. */
+    uOSMemSize_t             uxBlockSize;
+} tOSEventPool_t;
+
+TINIUX_DATA static tOSEventPool_t     gtOSEventPool[ OSEVENT_POOL_NUM ];
+TINIUX_DATA static uOSBase_t          guxOSEventPoolNum         = ( uOSBase_t ) 0U;
+
+TINIUX_DATA static tOSActive_t *      gptOSActive[ OSACTIVE_MAX_NUM ];
+TINIUX_DATA static uOSBase_t          guxOSActiveNum            = ( uOSBase_t ) 0U;
+
+/* The active objects subscribed to each signal, one bit per active object. */
+TINIUX_DATA static uOS32_t            guiOSActiveSubscriber[ OSACTIVE_MAX_SIGNAL ];
+
+TINIUX_DATA static tOSEvent_t const   gtOSReservedEvent[ OSSIG_USER ] =
+{
+    { OSSIG_EMPTY, 0U, 0U },
+    { OSSIG_ENTRY, 0U, 0U },
+    { OSSIG_EXIT,  0U, 0U },
+    { OSSIG_INIT,  0U, 0U }
+};
+
+/* Send a signal used by the state machine itself to a state. */
+#define OSACTIVE_TRIG( ptActive, pxState, usSignal )    ( ( *( pxState ) )( ( ptActive ), &gtOSReservedEvent[ ( usSignal ) ] ) )
+
+uOSBase_t OSActiveInit( void )
+{
+    uOSBase_t x = ( uOSBase_t ) 0;
+
+    guxOSEventPoolNum = ( uOSBase_t ) 0U;
+    guxOSActiveNum = ( uOSBase_t ) 0U;
+
+    for( x = ( uOSBase_t ) 0; x < ( uOSBase_t ) OSACTIVE_MAX_SIGNAL; x++ )
+    {
+        guiOSActiveSubscriber[ x ] = 0UL;
+    }
+
+    return 0U;
+}
+
+/* Pools have to be created smallest block size first, a new event comes from
+the first pool with blocks large enough. */
+uOSBool_t OSEventPoolCreate( uOSMemSize_t uxBlockSize, uOSBase_t uxBlockNum )
+{
+    uOS8_t * pucBlock = OS_NULL;
+    tOSEventPool_t * ptPool = OS_NULL;
+    uOSBase_t x = ( uOSBase_t ) 0;
+
+    if( ( guxOSEventPoolNum >= ( uOSBase_t ) OSEVENT_POOL_NUM ) || ( uxBlockNum == ( uOSBase_t ) 0U ) )
+    {
+        return OS_FALSE;
+    }
+
+    /* A free block holds the link to the next one. */
+    if( uxBlockSize < ( uOSMemSize_t ) sizeof( tOSEvent_t ) )
+    {
+        uxBlockSize = ( uOSMemSize_t ) sizeof( tOSEvent_t );
+    }
+    uxBlockSize = ( ( uxBlockSize + sizeof( void * ) - 1U ) / sizeof( void * ) ) * sizeof( void * );
+
+    pucBlock = ( uOS8_t * ) OSMemMalloc( ( uOSMemSize_t ) ( uxBlockSize * uxBlockNum ) );
+    if( pucBlock == OS_NULL )
+    {
+        return OS_FALSE;
+    }
+
+    OSIntLock();
+    {
+        ptPool = &gtOSEventPool[ guxOSEventPoolNum ];
+        ptPool->uxBlockSize = uxBlockSize;
+        ptPool->pvFreeList = OS_NULL;
+        for( x = ( uOSBase_t ) 0; x < uxBlockNum; x++ )
+        {
+            *( void ** ) pucBlock = ptPool->pvFreeList;
+            ptPool->pvFreeList = pucBlock;
+            pucBlock += uxBlockSize;
+        }
+        guxOSEventPoolNum++;
+    }
+    OSIntUnlock();
+
+    return OS_TRUE;
+}
+
+/* Called with interrupts masked. */
+static tOSEvent_t * OSEventPoolGet( uOSMemSize_t uxSize, uOS16_t usSignal )
+{
+    tOSEventPool_t * ptPool = OS_NULL;
+    tOSEvent_t * ptEvent = OS_NULL;
+    uOSBase_t x = ( uOSBase_t ) 0;
+
+    for( x = ( uOSBase_t ) 0; x < guxOSEventPoolNum; x++ )
+    {
+        ptPool = &gtOSEventPool[ x ];
+        if( ptPool->uxBlockSize >= uxSize )
+        {
+            ptEvent = ( tOSEvent_t * ) ptPool->pvFreeList;
+            if( ptEvent != OS_NULL )
+            {
+                ptPool->pvFreeList = *( void ** ) ptEvent;
+
+                ptEvent->usSignal = usSignal;
+                ptEvent->ucPoolID = ( uOS8_t ) ( x + 1U );
+                ptEvent->ucRefCount = 0U;
+            }
+            break;
+        }
+    }
+
+    return ptEvent;
+}
+
+/* Called with interrupts masked. */
+static void OSEventPoolPut( const tOSEvent_t * const ptEvent )
+{
+    tOSEventPool_t * const ptPool = &gtOSEventPool[ ptEvent->ucPoolID - 1U ];
+
+    *( void ** ) ptEvent = ptPool->pvFreeList;
+    ptPool->pvFreeList = ( void * ) ptEvent;
+}
+
+tOSEvent_t * OSEventNew( uOSMemSize_t uxSize, uOS16_t usSignal )
+{
+    tOSEvent_t * ptEvent = OS_NULL;
+
+    OSIntLock();
+    {
+        ptEvent = OSEventPoolGet( uxSize, usSignal );
+    }
+    OSIntUnlock();
+
+    return ptEvent;
+}
+
+tOSEvent_t * OSEventNewFromISR( uOSMemSize_t uxSize, uOS16_t usSignal )
+{
+    tOSEvent_t * ptEvent = OS_NULL;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+
+    uxIntSave = OSIntMaskFromISR();
+    {
+        ptEvent = OSEventPoolGet( uxSize, usSignal );
+    }
+    OSIntUnmaskFromISR( uxIntSave );
+
+    return ptEvent;
+}
+
+/* Called with interrupts masked, an event from a pool no active object got
+goes back to its pool. */
+static void OSEventRecycleUnused( const tOSEvent_t * const ptEvent )
+{
+    if( ( ptEvent->ucPoolID != 0U ) && ( ptEvent->ucRefCount == 0U ) )
+    {
+        OSEventPoolPut( ptEvent );
+    }
+}
+
+/* An active object has handled the event. */
+static void OSEventGC( const tOSEvent_t * const ptEvent )
+{
+    tOSEvent_t * const ptPoolEvent = ( tOSEvent_t * ) ptEvent;
+
+    if( ptEvent->ucPoolID != 0U )
+    {
+        OSIntLock();
+        {
+            if( ptPoolEvent->ucRefCount > 1U )
+            {
+                ptPoolEvent->ucRefCount--;
+            }
+            else
+            {
+                ptPoolEvent->ucRefCount = 0U;
+                OSEventPoolPut( ptEvent );
+            }
+        }
+        OSIntUnlock();
+    }
+}
+
+/* The top state, every state nests in it. */
+uOSBase_t OSActiveTop( tOSActive_t * const ptActive, const tOSEvent_t * const ptEvent )
+{
+    ( void ) ptActive;
+    ( void ) ptEvent;
+
+    return OSSTATE_IGNORED;
+}
+
+static OSStateHandler_t OSActiveSuper( tOSActive_t * const ptActive, OSStateHandler_t pxState )
+{
+    OSStateHandler_t pxSuper = OS_NULL;
+
+    if( OSACTIVE_TRIG( ptActive, pxState, OSSIG_EMPTY ) == OSSTATE_SUPER )
+    {
+        pxSuper = ptActive->pxTemp;
+    }
+
+    return pxSuper;
+}
+
+/* Enter the states below pxFrom down to pxTarget, outermost first. */
+static void OSActiveEnter( tOSActive_t * const ptActive, OSStateHandler_t pxFrom, OSStateHandler_t pxTarget )
+{
+    OSStateHandler_t pxPath[ OSACTIVE_MAX_NEST ];
+    OSStateHandler_t pxState = pxTarget;
+    uOSBase_t uxNum = ( uOSBase_t ) 0U;
+
+    while( ( pxState != pxFrom ) && ( pxState != OS_NULL ) && ( uxNum < ( uOSBase_t ) OSACTIVE_MAX_NEST ) )
+    {
+        pxPath[ uxNum ] = pxState;
+        uxNum++;
+        pxState = OSActiveSuper( ptActive, pxState );
+    }
+
+    while( uxNum > ( uOSBase_t ) 0U )
+    {
+        uxNum--;
+        ( void ) OSACTIVE_TRIG( ptActive, pxPath[ uxNum ], OSSIG_ENTRY );
+    }
+}
+
+/* Take the initial transitions down to a leaf state. */
+static void OSActiveDrill( tOSActive_t * const ptActive )
+{
+    OSStateHandler_t pxTarget = OS_NULL;
+
+    while( OSACTIVE_TRIG( ptActive, ptActive->pxState, OSSIG_INIT ) == OSSTATE_TRAN )
+    {
+        pxTarget = ptActive->pxTemp;
+        OSActiveEnter( ptActive, ptActive->pxState, pxTarget );
+        ptActive->pxState = pxTarget;
+    }
+}
+
+/* Run the event to completion in the state machine. */
+static void OSActiveDispatch( tOSActive_t * const ptActive, const tOSEvent_t * const ptEvent )
+{
+    OSStateHandler_t pxPath[ OSACTIVE_MAX_NEST ];
+    OSStateHandler_t pxSource = ptActive->pxState;
+    OSStateHandler_t pxTarget = OS_NULL;
+    OSStateHandler_t pxState = OS_NULL;
+    uOSBase_t uxNum = ( uOSBase_t ) 0U;
+    uOSBase_t uxIndex = ( uOSBase_t ) 0U;
+    uOSBase_t uxResult = OSSTATE_IGNORED;
+
+    /* Offer the event to the current state and then to its super states,
+    up to the first one handling it. */
+    for( ;; )
+    {
+        uxResult = ( *pxSource )( ptActive, ptEvent );
+        if( uxResult != OSSTATE_SUPER )
+        {
+            break;
+        }
+        pxSource = ptActive->pxTemp;
+    }
+
+    if( uxResult != OSSTATE_TRAN )
+    {
+        return;
+    }
+    pxTarget = ptActive->pxTemp;
+
+    /* Exit the states nested in the source of the transition. */
+    for( pxState = ptActive->pxState; pxState != pxSource; pxState = OSActiveSuper( ptActive, pxState ) )
+    {
+        ( void ) OSACTIVE_TRIG( ptActive, pxState, OSSIG_EXIT );
+    }
+
+    /* The path from the target up to the top state. */
+    for( pxState = pxTarget; ( pxState != OS_NULL ) && ( uxNum < ( uOSBase_t ) OSACTIVE_MAX_NEST ); pxState = OSActiveSuper( ptActive, pxState ) )
+    {
+        pxPath[ uxNum ] = pxState;
+        uxNum++;
+    }
+
+    /* A transition to itself leaves the source and enters it again. */
+    if( pxSource == pxTarget )
+    {
+        ( void ) OSACTIVE_TRIG( ptActive, pxSource, OSSIG_EXIT );
+        pxSource = OSActiveSuper( ptActive, pxSource );
+    }
+
+    /* Exit up to the innermost state containing both source and target. */
+    for( ;; )
+    {
+        for( uxIndex = ( uOSBase_t ) 0U; uxIndex < uxNum; uxIndex++ )
+        {
+            if( pxPath[ uxIndex ] == pxSource )
+            {
+                break;
+            }
+        }
+        if( ( uxIndex < uxNum ) || ( pxSource == OS_NULL ) )
+        {
+            break;
+        }
+
+        ( void ) OSACTIVE_TRIG( ptActive, pxSource, OSSIG_EXIT );
+        pxSource = OSActiveSuper( ptActive, pxSource );
+    }
+
+    /* Enter down to the target. */
+    while( uxIndex > ( uOSBase_t ) 0U )
+    {
+        uxIndex--;
+        ( void ) OSACTIVE_TRIG( ptActive, pxPath[ uxIndex ], OSSIG_ENTRY );
+    }
+
+    ptActive->pxState = pxTarget;
+    OSActiveDrill( ptActive );
+}
+
+/* Basic task of an active object, one activation per event posted. */
+static void OSActiveRun( void * pvParameter )
+{
+    tOSActive_t * const ptActive = ( tOSActive_t * ) pvParameter;
+    const tOSEvent_t * ptEvent = OS_NULL;
+
+    OSIntLock();
+    {
+        if( ptActive->uxQueueNum > ( uOSBase_t ) 0U )
+        {
+            ptEvent = ptActive->pptQueue[ ptActive->uxQueueHead ];
+            ptActive->uxQueueHead++;
+            if( ptActive->uxQueueHead >= ptActive->uxQueueLength )
+            {
+                ptActive->uxQueueHead = ( uOSBase_t ) 0U;
+            }
+            ptActive->uxQueueNum--;
+        }
+    }
+    OSIntUnlock();
+
+    if( ptEvent != OS_NULL )
+    {
+        OSActiveDispatch( ptActive, ptEvent );
+        OSEventGC( ptEvent );
+    }
+}
+
+/* Start the active object in the state pxInitial transitions to, its events
+are handled by a basic task of uxPriority. The initial transition runs in
+the caller. */
+uOSBool_t OSActiveStart( OSActiveHandle_t ActiveHandle, OSStateHandler_t pxInitial, uOSBase_t uxPriority, uOSBase_t uxQueueLength )
+{
+    tOSActive_t * const ptActive = ( tOSActive_t * ) ActiveHandle;
+    OSStateHandler_t pxTarget = OS_NULL;
+
+    if( ( guxOSActiveNum >= ( uOSBase_t ) OSACTIVE_MAX_NUM ) || ( uxQueueLength == ( uOSBase_t ) 0U ) )
+    {
+        return OS_FALSE;
+    }
+
+    ptActive->pptQueue = ( const tOSEvent_t ** ) OSMemMalloc( ( uOSMemSize_t ) ( sizeof( tOSEvent_t * ) * uxQueueLength ) );
+    if( ptActive->pptQueue == OS_NULL )
+    {
+        return OS_FALSE;
+    }
+    ptActive->uxQueueLength = uxQueueLength;
+    ptActive->uxQueueHead = ( uOSBase_t ) 0U;
+    ptActive->uxQueueNum = ( uOSBase_t ) 0U;
+
+    ptActive->BasicTaskHandle = OSBasicTaskCreate( OSActiveRun, ptActive, uxPriority );
+    if( ptActive->BasicTaskHandle == OS_NULL )
+    {
+        #if ( OS_MEMFREE_ON != 0 )
+        OSMemFree( ( void * ) ptActive->pptQueue );
+        #endif /* OS_MEMFREE_ON */
+        return OS_FALSE;
+    }
+
+    ptActive->pxState = OSActiveTop;
+    ptActive->pxTemp = OS_NULL;
+    if( ( *pxInitial )( ptActive, &gtOSReservedEvent[ OSSIG_INIT ] ) == OSSTATE_TRAN )
+    {
+        pxTarget = ptActive->pxTemp;
+        OSActiveEnter( ptActive, OSActiveTop, pxTarget );
+        ptActive->pxState = pxTarget;
+        OSActiveDrill( ptActive );
+    }
+
+    OSIntLock();
+    {
+        ptActive->uxID = guxOSActiveNum;
+        gptOSActive[ guxOSActiveNum ] = ptActive;
+        guxOSActiveNum++;
+    }
+    OSIntUnlock();
+
+    return OS_TRUE;
+}
+
+/* Called with interrupts masked, only the pointer to the event is queued. */
+static uOSBool_t OSActiveQueuePut( tOSActive_t * const ptActive, const tOSEvent_t * const ptEvent )
+{
+    uOSBase_t uxIndex = ( uOSBase_t ) 0U;
+
+    if( ptActive->uxQueueNum >= ptActive->uxQueueLength )
+    {
+        return OS_FALSE;
+    }
+
+    uxIndex = ptActive->uxQueueHead + ptActive->uxQueueNum;
+    if( uxIndex >= ptActive->uxQueueLength )
+    {
+        uxIndex -= ptActive->uxQueueLength;
+    }
+    ptActive->pptQueue[ uxIndex ] = ptEvent;
+    ptActive->uxQueueNum++;
+
+    if( ptEvent->ucPoolID != 0U )
+    {
+        ( ( tOSEvent_t * ) ptEvent )->ucRefCount++;
+    }
+
+    return OS_TRUE;
+}
+
+uOSBool_t OSActivePost( OSActiveHandle_t ActiveHandle, const tOSEvent_t * const ptEvent )
+{
+    uOSBool_t bReturn = OS_FALSE;
+
+    OSIntLock();
+    {
+        bReturn = OSActiveQueuePut( ActiveHandle, ptEvent );
+        if( bReturn == OS_FALSE )
+        {
+            OSEventRecycleUnused( ptEvent );
+        }
+    }
+    OSIntUnlock();
+
+    if( bReturn != OS_FALSE )
+    {
+        ( void ) OSBasicTaskActivate( ActiveHandle->BasicTaskHandle );
+    }
+
+    return bReturn;
+}
+
+uOSBool_t OSActivePostFromISR( OSActiveHandle_t ActiveHandle, const tOSEvent_t * const ptEvent )
+{
+    uOSBool_t bReturn = OS_FALSE;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+
+    uxIntSave = OSIntMaskFromISR();
+    {
+        bReturn = OSActiveQueuePut( ActiveHandle, ptEvent );
+        if( bReturn == OS_FALSE )
+        {
+            OSEventRecycleUnused( ptEvent );
+        }
+    }
+    OSIntUnmaskFromISR( uxIntSave );
+
+    if( bReturn != OS_FALSE )
+    {
+        ( void ) OSBasicTaskActivateFromISR( ActiveHandle->BasicTaskHandle );
+    }
+
+    return bReturn;
+}
+
+void OSActiveSubscribe( OSActiveHandle_t ActiveHandle, uOS16_t usSignal )
+{
+    if( usSignal < ( uOS16_t ) OSACTIVE_MAX_SIGNAL )
+    {
+        OSIntLock();
+        {
+            guiOSActiveSubscriber[ usSignal ] |= ( ( uOS32_t ) 1UL << ActiveHandle->uxID );
+        }
+        OSIntUnlock();
+    }
+}
+
+void OSActiveUnsubscribe( OSActiveHandle_t ActiveHandle, uOS16_t usSignal )
+{
+    if( usSignal < ( uOS16_t ) OSACTIVE_MAX_SIGNAL )
+    {
+        OSIntLock();
+        {
+            guiOSActiveSubscriber[ usSignal ] &= ~( ( uOS32_t ) 1UL << ActiveHandle->uxID );
+        }
+        OSIntUnlock();
+    }
+}
+
+/* Called with interrupts masked, queues the event to every subscriber before
+any of them can run, so the event is not recycled before the last one got
+it. Returns the subscribers posted to. */
+static uOS32_t OSActivePublishLocked( const tOSEvent_t * const ptEvent )
+{
+    uOS32_t uiSubscriber = 0UL;
+    uOS32_t uiPosted = 0UL;
+    uOSBase_t x = ( uOSBase_t ) 0;
+
+    if( ptEvent->usSignal < ( uOS16_t ) OSACTIVE_MAX_SIGNAL )
+    {
+        uiSubscriber = guiOSActiveSubscriber[ ptEvent->usSignal ];
+    }
+
+    for( x = ( uOSBase_t ) 0; ( x < guxOSActiveNum ) && ( uiSubscriber != 0UL ); x++ )
+    {
+        if( ( uiSubscriber & ( ( uOS32_t ) 1UL << x ) ) != 0UL )
+        {
+            uiSubscriber &= ~( ( uOS32_t ) 1UL << x );
+            if( OSActiveQueuePut( gptOSActive[ x ], ptEvent ) != OS_FALSE )
+            {
+                uiPosted |= ( ( uOS32_t ) 1UL << x );
+            }
+        }
+    }
+
+    OSEventRecycleUnused( ptEvent );
+
+    return uiPosted;
+}
+
+/* Post the event to every active object subscribed to its signal, returns
+the number of active objects it was posted to. */
+uOSBase_t OSActivePublish( const tOSEvent_t * const ptEvent )
+{
+    uOS32_t uiPosted = 0UL;
+    uOSBase_t uxNum = ( uOSBase_t ) 0U;
+    uOSBase_t x = ( uOSBase_t ) 0;
+
+    OSIntLock();
+    {
+        uiPosted = OSActivePublishLocked( ptEvent );
+    }
+    OSIntUnlock();
+
+    for( x = ( uOSBase_t ) 0; uiPosted != 0UL; x++ )
+    {
+        if( ( uiPosted & ( ( uOS32_t ) 1UL << x ) ) != 0UL )
+        {
+            uiPosted &= ~( ( uOS32_t ) 1UL << x );
+            ( void ) OSBasicTaskActivate( gptOSActive[ x ]->BasicTaskHandle );
+            uxNum++;
+        }
+    }
+
+    return uxNum;
+}
+
+uOSBase_t OSActivePublishFromISR( const tOSEvent_t * const ptEvent )
+{
+    uOS32_t uiPosted = 0UL;
+    uOSBase_t uxNum = ( uOSBase_t ) 0U;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+    uOSBase_t x = ( uOSBase_t ) 0;
+
+    uxIntSave = OSIntMaskFromISR();
+    {
+        uiPosted = OSActivePublishLocked( ptEvent );
+    }
+    OSIntUnmaskFromISR( uxIntSave );
+
+    for( x = ( uOSBase_t ) 0; uiPosted != 0UL; x++ )
+    {
+        if( ( uiPosted & ( ( uOS32_t ) 1UL << x ) ) != 0UL )
+        {
+            uiPosted &= ~( ( uOS32_t ) 1UL << x );
+            ( void ) OSBasicTaskActivateFromISR( gptOSActive[ x ]->BasicTaskHandle );
+            uxNum++;
+        }
+    }
+
+    return uxNum;
+}
+
+#endif //( OS_ACTIVE_ON!=0 )
+
+#ifdef __cplusplus
+}
+#endif
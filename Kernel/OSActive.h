@@ -0,0 +1,125 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#ifndef __OS_ACTIVE_H_
+#define __OS_ACTIVE_H_
+
+#include "OSType.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( OS_ACTIVE_ON!=0 )
+
+/* Signals used by the state machine itself, application signals start at
+OSSIG_USER. */
+#define OSSIG_EMPTY                 ( ( uOS16_t ) 0 )
+#define OSSIG_ENTRY                 ( ( uOS16_t ) 1 )
+#define OSSIG_EXIT                  ( ( uOS16_t ) 2 )
+#define OSSIG_INIT                  ( ( uOS16_t ) 3 )
+#define OSSIG_USER                  ( ( uOS16_t ) 4 )
+
+/* Values returned by a state handler. */
+#define OSSTATE_HANDLED             ( ( uOSBase_t ) 0 )
+#define OSSTATE_IGNORED             ( ( uOSBase_t ) 1 )
+#define OSSTATE_TRAN                ( ( uOSBase_t ) 2 )
+#define OSSTATE_SUPER               ( ( uOSBase_t ) 3 )
+
+/*
+ * Event. An application event has a tOSEvent_t as its first member. An event
+ * taken from a pool must not be changed once posted, it goes back to its pool
+ * when the last active object it was posted to has handled it.
+ */
+typedef struct tOSEvent
+{
+    uOS16_t                  usSignal;
+    uOS8_t                   ucPoolID;                   /*< The pool of the event plus one, 0 for an event not from a pool. */
+    volatile uOS8_t          ucRefCount;                 /*< Number of active objects the event is posted to and not handled by yet. */
+} tOSEvent_t;
+
+struct tOSActive;
+typedef uOSBase_t (*OSStateHandler_t)( struct tOSActive * const ptActive, const tOSEvent_t * const ptEvent );
+
+/*
+ * Active object. An application active object has a tOSActive_t as its first
+ * member. Each event posted to it is handled to completion by the state
+ * machine on a basic task, so active objects share one stack by priority.
+ */
+typedef struct tOSActive
+{
+    OSStateHandler_t         pxState;                    /*< The current state, always a leaf state. */
+    OSStateHandler_t         pxTemp;                     /*< The target of a transition or the super state, set by a state handler. */
+    OSBasicTaskHandle_t      BasicTaskHandle;
+    const tOSEvent_t **      pptQueue;                   /*< Ring of the events posted and not handled yet. */
+    uOSBase_t                uxQueueLength;
+    uOSBase_t                uxQueueHead;
+    volatile uOSBase_t       uxQueueNum;
+    uOSBase_t                uxID;                       /*< Index of the active object, its bit in the subscriber sets. */
+} tOSActive_t;
+
+typedef    tOSActive_t*      OSActiveHandle_t;
+
+/* State handlers return one of these. */
+#define OSStateHandled( ptActive )                  ( OSSTATE_HANDLED )
+#define OSStateIgnored( ptActive )                  ( OSSTATE_IGNORED )
+#define OSStateTran( ptActive, pxTarget )           ( ( ( OSActiveHandle_t ) ( ptActive ) )->pxTemp = ( OSStateHandler_t ) ( pxTarget ), OSSTATE_TRAN )
+#define OSStateSuper( ptActive, pxSuper )           ( ( ( OSActiveHandle_t ) ( ptActive ) )->pxTemp = ( OSStateHandler_t ) ( pxSuper ), OSSTATE_SUPER )
+
+uOSBase_t         OSActiveInit( void ) TINIUX_FUNCTION;
+
+uOSBool_t         OSEventPoolCreate( uOSMemSize_t uxBlockSize, uOSBase_t uxBlockNum ) TINIUX_FUNCTION;
+tOSEvent_t *      OSEventNew( uOSMemSize_t uxSize, uOS16_t usSignal ) TINIUX_FUNCTION;
+tOSEvent_t *      OSEventNewFromISR( uOSMemSize_t uxSize, uOS16_t usSignal ) TINIUX_FUNCTION;
+
+uOSBase_t         OSActiveTop( tOSActive_t * const ptActive, const tOSEvent_t * const ptEvent ) TINIUX_FUNCTION;
+uOSBool_t         OSActiveStart( OSActiveHandle_t ActiveHandle, OSStateHandler_t pxInitial, uOSBase_t uxPriority, uOSBase_t uxQueueLength ) TINIUX_FUNCTION;
+uOSBool_t         OSActivePost( OSActiveHandle_t ActiveHandle, const tOSEvent_t * const ptEvent ) TINIUX_FUNCTION;
+uOSBool_t         OSActivePostFromISR( OSActiveHandle_t ActiveHandle, const tOSEvent_t * const ptEvent ) TINIUX_FUNCTION;
+
+void              OSActiveSubscribe( OSActiveHandle_t ActiveHandle, uOS16_t usSignal ) TINIUX_FUNCTION;
+void              OSActiveUnsubscribe( OSActiveHandle_t ActiveHandle, uOS16_t usSignal ) TINIUX_FUNCTION;
+uOSBase_t         OSActivePublish( const tOSEvent_t * const ptEvent ) TINIUX_FUNCTION;
+uOSBase_t         OSActivePublishFromISR( const tOSEvent_t * const ptEvent ) TINIUX_FUNCTION;
+
+#endif //( OS_ACTIVE_ON!=0 )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__OS_ACTIVE_H_
@@ -0,0 +1,264 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#include "TINIUX.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( OS_BASIC_TASK_ON!=0 )
+
+/* Activated basic tasks, one FIFO per priority. */
+TINIUX_DATA static tOSBasicTask_t *   gptOSBasicReadyHead[ OSBASIC_PRIORITIES ];
+TINIUX_DATA static tOSBasicTask_t *   gptOSBasicReadyTail[ OSBASIC_PRIORITIES ];
+
+TINIUX_DATA static OSTaskHandle_t     gOSBasicMoniteTaskHandle  = OS_NULL;
+
+uOSBase_t OSBasicTaskInit( void )
+{
+    uOSBase_t x = ( uOSBase_t ) 0;
+
+    for( x = ( uOSBase_t ) 0; x < ( uOSBase_t ) OSBASIC_PRIORITIES; x++ )
+    {
+        gptOSBasicReadyHead[ x ] = OS_NULL;
+        gptOSBasicReadyTail[ x ] = OS_NULL;
+    }
+    gOSBasicMoniteTaskHandle = OS_NULL;
+
+    return 0U;
+}
+
+OSBasicTaskHandle_t OSBasicTaskCreate( OSTaskFunction_t pxTaskFunction, void* pvParameter, uOSBase_t uxPriority )
+{
+    tOSBasicTask_t *ptNewBasicTask = OS_NULL;
+
+    if( uxPriority >= ( uOSBase_t ) OSBASIC_PRIORITIES )
+    {
+        uxPriority = ( uOSBase_t ) OSBASIC_PRIORITIES - ( uOSBase_t ) 1U;
+    }
+
+    ptNewBasicTask = ( tOSBasicTask_t * ) OSMemMalloc( sizeof( tOSBasicTask_t ) );
+    if( ptNewBasicTask != OS_NULL )
+    {
+        ptNewBasicTask->ptNext = OS_NULL;
+        ptNewBasicTask->pxTaskFunction = pxTaskFunction;
+        ptNewBasicTask->pvParameter = pvParameter;
+        ptNewBasicTask->uxPriority = uxPriority;
+        ptNewBasicTask->uxActivations = ( uOSBase_t ) 0U;
+    }
+
+    return ptNewBasicTask;
+}
+
+/* Called with interrupts masked. */
+static void OSBasicTaskReadyAdd( tOSBasicTask_t * const ptBasicTask )
+{
+    const uOSBase_t uxPriority = ptBasicTask->uxPriority;
+
+    ptBasicTask->ptNext = OS_NULL;
+    if( gptOSBasicReadyTail[ uxPriority ] == OS_NULL )
+    {
+        gptOSBasicReadyHead[ uxPriority ] = ptBasicTask;
+    }
+    else
+    {
+        gptOSBasicReadyTail[ uxPriority ]->ptNext = ptBasicTask;
+    }
+    gptOSBasicReadyTail[ uxPriority ] = ptBasicTask;
+}
+
+/* Called with interrupts masked, returns the next activation to run. */
+static tOSBasicTask_t * OSBasicTaskReadyTake( void )
+{
+    tOSBasicTask_t * ptBasicTask = OS_NULL;
+    uOSBase_t uxPriority = ( uOSBase_t ) OSBASIC_PRIORITIES;
+
+    while( uxPriority > ( uOSBase_t ) 0U )
+    {
+        uxPriority--;
+
+        ptBasicTask = gptOSBasicReadyHead[ uxPriority ];
+        if( ptBasicTask != OS_NULL )
+        {
+            gptOSBasicReadyHead[ uxPriority ] = ptBasicTask->ptNext;
+            if( ptBasicTask->ptNext == OS_NULL )
+            {
+                gptOSBasicReadyTail[ uxPriority ] = OS_NULL;
+            }
+
+            /* Further activations queue up behind the tasks of the same
+            priority activated meanwhile. */
+            ptBasicTask->uxActivations--;
+            if( ptBasicTask->uxActivations != ( uOSBase_t ) 0U )
+            {
+                OSBasicTaskReadyAdd( ptBasicTask );
+            }
+            break;
+        }
+    }
+
+    return ptBasicTask;
+}
+
+/* Called with interrupts masked, returns OS_TRUE if the basic task was not
+activated before. */
+static uOSBool_t OSBasicTaskActivateLocked( tOSBasicTask_t * const ptBasicTask )
+{
+    uOSBool_t bReturn = OS_FALSE;
+
+    if( ptBasicTask->uxActivations == ( uOSBase_t ) 0U )
+    {
+        OSBasicTaskReadyAdd( ptBasicTask );
+        bReturn = OS_TRUE;
+    }
+    ptBasicTask->uxActivations++;
+
+    return bReturn;
+}
+
+uOSBool_t OSBasicTaskActivate( OSBasicTaskHandle_t const BasicTaskHandle )
+{
+    uOSBool_t bReturn = OS_FALSE;
+
+    if( BasicTaskHandle == OS_NULL )
+    {
+        return OS_FALSE;
+    }
+
+    OSIntLock();
+    {
+        bReturn = OSBasicTaskActivateLocked( BasicTaskHandle );
+    }
+    OSIntUnlock();
+
+    if( gOSBasicMoniteTaskHandle != OS_NULL )
+    {
+        ( void ) OSTaskSignalEmit( gOSBasicMoniteTaskHandle );
+    }
+
+    return bReturn;
+}
+
+uOSBool_t OSBasicTaskActivateFromISR( OSBasicTaskHandle_t const BasicTaskHandle )
+{
+    uOSBool_t bReturn = OS_FALSE;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+    uOSBool_t bNeedSchedule = OS_FALSE;
+
+    if( BasicTaskHandle == OS_NULL )
+    {
+        return OS_FALSE;
+    }
+
+    uxIntSave = OSIntMaskFromISR();
+    {
+        bReturn = OSBasicTaskActivateLocked( BasicTaskHandle );
+    }
+    OSIntUnmaskFromISR( uxIntSave );
+
+    if( gOSBasicMoniteTaskHandle != OS_NULL )
+    {
+        /* Switch to the monitor task when the interrupt returns if it runs
+        above the interrupted task. */
+        if( ( OSTaskSignalEmitFromISR( gOSBasicMoniteTaskHandle ) != OS_FALSE ) &&
+            ( OSTaskGetPriorityFromISR( gOSBasicMoniteTaskHandle ) > OSTaskGetPreemptPriority() ) )
+        {
+            bNeedSchedule = OS_TRUE;
+        }
+    }
+
+    if(SCHEDULER_RUNNING == OSScheduleGetState())
+    {
+        OSScheduleFromISR( bNeedSchedule );
+    }
+
+    return bReturn;
+}
+
+#if ( OS_TIMER_ON!=0 )
+void OSBasicTaskTimerCallback( void * pvParameter )
+{
+    ( void ) OSBasicTaskActivate( ( OSBasicTaskHandle_t ) pvParameter );
+}
+#endif //( OS_TIMER_ON!=0 )
+
+static void OSBasicTaskMonite( void *pvParameter )
+{
+    tOSBasicTask_t * ptBasicTask = OS_NULL;
+
+    ( void ) pvParameter;
+
+    for( ;; )
+    {
+        OSIntLock();
+        {
+            ptBasicTask = OSBasicTaskReadyTake();
+        }
+        OSIntUnlock();
+
+        if( ptBasicTask != OS_NULL )
+        {
+            /* Run the activation to completion, there is no context to
+            save between basic tasks. */
+            ptBasicTask->pxTaskFunction( ptBasicTask->pvParameter );
+        }
+        else
+        {
+            ( void ) OSTaskSignalWait( OSPEND_FOREVER_VALUE );
+        }
+    }
+}
+
+uOSBool_t OSBasicTaskCreateMoniteTask( void )
+{
+    uOSBool_t bReturn = OS_FALSE;
+
+    gOSBasicMoniteTaskHandle = OSTaskCreate( OSBasicTaskMonite, OS_NULL, OSBASIC_TASK_STACK_SIZE, OSBASIC_TASK_PRIO, "OSBasicTask" );
+    if( gOSBasicMoniteTaskHandle != OS_NULL )
+    {
+        bReturn = OS_TRUE;
+    }
+
+    return bReturn;
+}
+
+#endif //( OS_BASIC_TASK_ON!=0 )
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,202 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#include "TINIUX.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( OS_COND_ON!=0 )
+
+OSCondHandle_t OSCondCreate( void )
+{
+    tOSCond_t *ptNewCond = OS_NULL;
+
+    ptNewCond = ( tOSCond_t * ) OSMemMalloc( sizeof( tOSCond_t ) );
+    if( ptNewCond != OS_NULL )
+    {
+        /* Ensure the event queue starts with the correct state. */
+        OSListInit( &( ptNewCond->tTaskListEventCond ) );
+    }
+    return (OSCondHandle_t)ptNewCond;
+}
+
+#if ( OS_MEMFREE_ON != 0 )
+void OSCondDelete( OSCondHandle_t CondHandle )
+{
+    tOSCond_t * const ptCond = ( tOSCond_t * ) CondHandle;
+
+    OSMemFree( ptCond );
+}
+#endif /* OS_MEMFREE_ON */
+
+sOSBase_t OSCondSetID(OSCondHandle_t CondHandle, sOSBase_t xID)
+{
+    if(CondHandle == OS_NULL)
+    {
+        return 1;
+    }
+    OSIntLock();
+    {
+        CondHandle->xID = xID;
+    }
+    OSIntUnlock();
+
+    return 0;
+}
+
+sOSBase_t OSCondGetID(OSCondHandle_t const CondHandle)
+{
+    sOSBase_t xID = 0;
+
+    OSIntLock();
+    if(CondHandle != OS_NULL)
+    {
+        xID = CondHandle->xID;
+    }
+    OSIntUnlock();
+
+    return xID;
+}
+
+uOSBool_t OSCondWait( OSCondHandle_t CondHandle, OSMutexHandle_t MutexHandle, uOSTick_t uxTicksToWait )
+{
+    tOSTimeOut_t tTimeOut;
+    tOSCond_t * const ptCond = ( tOSCond_t * ) CondHandle;
+    tOSMutex_t * const ptMutex = ( tOSMutex_t * ) MutexHandle;
+    uOSBase_t uxMutexLocked = ( uOSBase_t ) 0U;
+    uOSBool_t bSignaled = OS_FALSE;
+
+    /* The calling task must hold the mutex. */
+    if( ptMutex->MutexHolderHandle != ( void * ) OSGetCurrentTaskHandle() )
+    {
+        return OS_FALSE;
+    }
+
+    if( uxTicksToWait == ( uOSTick_t ) 0 )
+    {
+        return OS_FALSE;
+    }
+
+    OSSetTimeOutState( &tTimeOut );
+
+    /* Releasing the mutex and blocking on the condition is one step for the
+    other tasks, as none of them can run until the scheduler is unlocked. */
+    OSScheduleLock();
+    {
+        /* Release the mutex completely, even if it was locked recursively. */
+        uxMutexLocked = ptMutex->uxMutexLocked;
+        ptMutex->uxMutexLocked = ( uOSBase_t ) 1U;
+        ( void ) OSMutexUnlock( ptMutex );
+
+        OSTaskListEventAdd( &( ptCond->tTaskListEventCond ), uxTicksToWait );
+    }
+    if( OSScheduleUnlock() == OS_FALSE )
+    {
+        OSSchedule();
+    }
+
+    /* Woken by a signal or by the timeout. */
+    if( OSGetTimeOutState( &tTimeOut, &uxTicksToWait ) == OS_FALSE )
+    {
+        bSignaled = OS_TRUE;
+    }
+
+    /* Take the mutex back before returning, priority inheritance applies
+    as for any other lock of the mutex. */
+    ( void ) OSMutexLock( ptMutex, OSPEND_FOREVER_VALUE );
+    ptMutex->uxMutexLocked = uxMutexLocked;
+
+    return bSignaled;
+}
+
+uOSBool_t OSCondSignal( OSCondHandle_t CondHandle )
+{
+    tOSCond_t * const ptCond = ( tOSCond_t * ) CondHandle;
+    uOSBool_t bReturn = OS_FALSE;
+
+    OSIntLock();
+    {
+        /* Wake the highest priority waiting task. */
+        if( OSListIsEmpty( &( ptCond->tTaskListEventCond ) ) == OS_FALSE )
+        {
+            if( OSTaskListEventRemove( &( ptCond->tTaskListEventCond ) ) != OS_FALSE )
+            {
+                OSSchedule();
+            }
+            bReturn = OS_TRUE;
+        }
+    }
+    OSIntUnlock();
+
+    return bReturn;
+}
+
+uOSBool_t OSCondBroadcast( OSCondHandle_t CondHandle )
+{
+    tOSCond_t * const ptCond = ( tOSCond_t * ) CondHandle;
+    uOSBool_t bNeedSchedule = OS_FALSE;
+    uOSBool_t bReturn = OS_FALSE;
+
+    OSIntLock();
+    {
+        /* Move all waiting tasks in one pass, and schedule only once. */
+        while( OSListIsEmpty( &( ptCond->tTaskListEventCond ) ) == OS_FALSE )
+        {
+            if( OSTaskListEventRemove( &( ptCond->tTaskListEventCond ) ) != OS_FALSE )
+            {
+                bNeedSchedule = OS_TRUE;
+            }
+            bReturn = OS_TRUE;
+        }
+
+        if( bNeedSchedule != OS_FALSE )
+        {
+            OSSchedule();
+        }
+    }
+    OSIntUnlock();
+
+    return bReturn;
+}
+
+#endif //( OS_COND_ON!=0 )
+
+#ifdef __cplusplus
+}
+#endif
@@ -103,9 +103,9 @@ typedef struct OSList
 void OSListItemInitialise( tOSListItem_t * const ptListItem );
 
 void OSListInit( tOSList_t * const ptList );
-void OSListInsertItem( tOSList_t * const ptList, tOSListItem_t * const ptNewListItem );
-void OSListInsertItemToEnd( tOSList_t * const ptList, tOSListItem_t * const ptNewListItem );
-uOSBase_t OSListRemoveItem( tOSListItem_t * const ptItemToRemove );
+void OSListInsertItem( tOSList_t * const ptList, tOSListItem_t * const ptNewListItem ) TINIUX_FAST_FUNCTION;
+void OSListInsertItemToEnd( tOSList_t * const ptList, tOSListItem_t * const ptNewListItem ) TINIUX_FAST_FUNCTION;
+uOSBase_t OSListRemoveItem( tOSListItem_t * const ptItemToRemove ) TINIUX_FAST_FUNCTION;
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,200 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#include "TINIUX.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( OS_MAILBOX_ON!=0 )
+
+/* Copy through volatile pointers, so the compiler keeps the copy between
+the two reads of the sequence. Whole words are copied when both sides are
+aligned. */
+static void OSMailboxCopy( volatile void * pvTo, const volatile void * pvFrom, uOSMemSize_t uxSize )
+{
+    volatile uOS8_t * pucTo = ( volatile uOS8_t * ) pvTo;
+    const volatile uOS8_t * pucFrom = ( const volatile uOS8_t * ) pvFrom;
+
+    if( ( ( ( uOSMemSize_t ) pucTo | ( uOSMemSize_t ) pucFrom ) & ( sizeof( uOSBase_t ) - 1U ) ) == 0U )
+    {
+        while( uxSize >= sizeof( uOSBase_t ) )
+        {
+            *( volatile uOSBase_t * ) pucTo = *( const volatile uOSBase_t * ) pucFrom;
+            pucTo += sizeof( uOSBase_t );
+            pucFrom += sizeof( uOSBase_t );
+            uxSize -= sizeof( uOSBase_t );
+        }
+    }
+    while( uxSize > 0U )
+    {
+        *pucTo++ = *pucFrom++;
+        uxSize--;
+    }
+}
+
+static void OSMailboxStore( tOSMailbox_t * const ptMailbox, const void * const pvItem )
+{
+    /* THIS FUNCTION MUST BE CALLED WITH THE INTERRUPT LOCKED. */
+    ( ptMailbox->uxSequence )++;
+    OSMailboxCopy( ptMailbox->pucItem, pvItem, ptMailbox->uxItemSize );
+    ( ptMailbox->uxSequence )++;
+
+    /* 0 is kept for a mailbox never written. */
+    if( ptMailbox->uxSequence == ( uOSBase_t ) 0U )
+    {
+        ptMailbox->uxSequence = ( uOSBase_t ) 2U;
+    }
+}
+
+OSMailboxHandle_t OSMailboxCreate( uOSMemSize_t uxItemSize )
+{
+    tOSMailbox_t *ptNewMailbox = OS_NULL;
+
+    ptNewMailbox = ( tOSMailbox_t * ) OSMemMalloc( ( uOSMemSize_t ) OSMEM_ALIGN_SIZE( sizeof( tOSMailbox_t ) ) + uxItemSize );
+    if( ptNewMailbox != OS_NULL )
+    {
+        ptNewMailbox->uxSequence = ( uOSBase_t ) 0U;
+        ptNewMailbox->uxItemSize = uxItemSize;
+        ptNewMailbox->pucItem = ( uOS8_t * ) ptNewMailbox + OSMEM_ALIGN_SIZE( sizeof( tOSMailbox_t ) );
+    }
+    return ( OSMailboxHandle_t ) ptNewMailbox;
+}
+
+#if ( OS_MEMFREE_ON != 0 )
+void OSMailboxDelete( OSMailboxHandle_t MailboxHandle )
+{
+    tOSMailbox_t * const ptMailbox = ( tOSMailbox_t * ) MailboxHandle;
+
+    OSMemFree( ptMailbox );
+}
+#endif /* OS_MEMFREE_ON */
+
+sOSBase_t OSMailboxSetID(OSMailboxHandle_t MailboxHandle, sOSBase_t xID)
+{
+    if(MailboxHandle == OS_NULL)
+    {
+        return 1;
+    }
+    OSIntLock();
+    {
+        MailboxHandle->xID = xID;
+    }
+    OSIntUnlock();
+
+    return 0;
+}
+
+sOSBase_t OSMailboxGetID(OSMailboxHandle_t const MailboxHandle)
+{
+    sOSBase_t xID = 0;
+
+    OSIntLock();
+    if(MailboxHandle != OS_NULL)
+    {
+        xID = MailboxHandle->xID;
+    }
+    OSIntUnlock();
+
+    return xID;
+}
+
+/* Writers only mask interrupts to keep out each other, they never wait for
+the readers. */
+void OSMailboxWrite( OSMailboxHandle_t MailboxHandle, const void * const pvItem )
+{
+    tOSMailbox_t * const ptMailbox = ( tOSMailbox_t * ) MailboxHandle;
+
+    OSIntLock();
+    {
+        OSMailboxStore( ptMailbox, pvItem );
+    }
+    OSIntUnlock();
+}
+
+void OSMailboxWriteFromISR( OSMailboxHandle_t MailboxHandle, const void * const pvItem )
+{
+    tOSMailbox_t * const ptMailbox = ( tOSMailbox_t * ) MailboxHandle;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+
+    uxIntSave = OSIntMaskFromISR();
+    {
+        OSMailboxStore( ptMailbox, pvItem );
+    }
+    OSIntUnmaskFromISR( uxIntSave );
+}
+
+/* Copies the latest value without masking interrupts, the copy is done
+again if a write happened meanwhile. Returns OS_FALSE if nothing was ever
+written. The sequence of the value read is returned in puxSequence if it
+is not OS_NULL, a reader can compare it to skip values it has seen. */
+uOSBool_t OSMailboxRead( OSMailboxHandle_t MailboxHandle, void * const pvBuffer, uOSBase_t * const puxSequence )
+{
+    tOSMailbox_t * const ptMailbox = ( tOSMailbox_t * ) MailboxHandle;
+    uOSBase_t uxSequence = ( uOSBase_t ) 0U;
+
+    for( ;; )
+    {
+        uxSequence = ptMailbox->uxSequence;
+        if( uxSequence == ( uOSBase_t ) 0U )
+        {
+            return OS_FALSE;
+        }
+        if( ( uxSequence & ( uOSBase_t ) 1U ) == ( uOSBase_t ) 0U )
+        {
+            OSMailboxCopy( pvBuffer, ptMailbox->pucItem, ptMailbox->uxItemSize );
+            if( uxSequence == ptMailbox->uxSequence )
+            {
+                break;
+            }
+        }
+    }
+
+    if( puxSequence != OS_NULL )
+    {
+        *puxSequence = uxSequence;
+    }
+
+    return OS_TRUE;
+}
+
+#endif //( OS_MAILBOX_ON!=0 )
+
+#ifdef __cplusplus
+}
+#endif
@@ -138,9 +138,11 @@ uOSBase_t OSMemInit(void)
 //	对齐内存分区首地址
     gpOSMemBegin = (uOS8_t *)OSMEM_ALIGN_ADDR(OSRAM_HEAP_POINTER);
 
+#if ( OS_MEM_ZERO_INIT_ON!=0 )
     /* Initialize the stack tiniux used. */
 //	初始化内存分区
     memset(gpOSMemBegin, 0U, OSMEM_SIZE_ALIGNED);
+#endif
 
     // initialize the start of the heap 
 //	初始化内存分区开始的节点
@@ -439,7 +439,7 @@ static uOSBool_t OSMsgQSendGeneralFromISR( OSMsgQHandle_t MsgQHandle, const void
             {
                 if( OSListIsEmpty( &( ptMsgQ->tTaskListEventMsgQP ) ) == OS_FALSE )
                 {
-                    if( OSTaskListEventRemove( &( ptMsgQ->tTaskListEventMsgQP ) ) != OS_FALSE )
+                    if( OSTaskListEventRemoveFromISR( &( ptMsgQ->tTaskListEventMsgQP ) ) != OS_FALSE )
                     {
                         if( pbNeedSchedule != OS_NULL )
                         {
@@ -700,7 +700,7 @@ uOSBool_t OSMsgQReceiveFromISR( OSMsgQHandle_t MsgQHandle, void * const pvBuffer
             {
                 if( OSListIsEmpty( &( ptMsgQ->tTaskListEventMsgQV ) ) == OS_FALSE )
                 {
-                    if( OSTaskListEventRemove( &( ptMsgQ->tTaskListEventMsgQV ) ) != OS_FALSE )
+                    if( OSTaskListEventRemoveFromISR( &( ptMsgQ->tTaskListEventMsgQV ) ) != OS_FALSE )
                     {
                         bNeedSchedule = OS_TRUE;
                     }
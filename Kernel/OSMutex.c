@@ -46,6 +46,9 @@ extern "C" {
 TINIUX_DATA static sOSBase_t const MUTEX_STATUS_UNLOCKED              = ( ( sOSBase_t ) -1 );
 TINIUX_DATA static sOSBase_t const MUTEX_STATUS_LOCKED                = ( ( sOSBase_t ) 0 );
 TINIUX_DATA static uOSTick_t const MUTEX_UNLOCK_BLOCK_TIME            = ( ( uOSTick_t ) 0U );
+#if ( OS_MUTEX_CEILING_ON!=0 )
+TINIUX_DATA static uOSBase_t const MUTEX_NO_CEILING                   = ( ( uOSBase_t ) OSHIGHEAST_PRIORITY );
+#endif //( OS_MUTEX_CEILING_ON!=0 )
 
 static uOSBool_t OSMutexIsEmpty( OSMutexHandle_t MutexHandle )
 {
@@ -171,6 +174,7 @@ OSMutexHandle_t OSMutexCreate( void )
     {
         /* Information required for priority inheritance. */
         ptNewMutex->MutexHolderHandle = OS_NULL;
+        ptNewMutex->ptNextHoldMutex = OS_NULL;
 
         ptNewMutex->uxCurNum = ( uOSBase_t ) 1U;
         ptNewMutex->uxMaxNum = ( uOSBase_t ) 1U;
@@ -183,9 +187,36 @@ OSMutexHandle_t OSMutexCreate( void )
         /* Ensure the event queues start with the correct state. */
         OSListInit( &( ptNewMutex->tTaskListEventMutexV ) );
         OSListInit( &( ptNewMutex->tTaskListEventMutexP ) );
+
+        #if ( OS_MUTEX_CEILING_ON!=0 )
+        {
+            ptNewMutex->uxCeilingPriority = MUTEX_NO_CEILING;
+        }
+        #endif //( OS_MUTEX_CEILING_ON!=0 )
+    }
+    return (OSMutexHandle_t)ptNewMutex;
+}
+
+#if ( OS_MUTEX_CEILING_ON!=0 )
+OSMutexHandle_t OSMutexCreateCeiling( uOSBase_t uxCeilingPriority )
+{
+    tOSMutex_t *ptNewMutex = OS_NULL;
+
+    if( uxCeilingPriority >= ( uOSBase_t ) OSHIGHEAST_PRIORITY )
+    {
+        uxCeilingPriority = ( uOSBase_t ) OSHIGHEAST_PRIORITY - 1;
+    }
+
+    ptNewMutex = ( tOSMutex_t * ) OSMutexCreate();
+    if( ptNewMutex != OS_NULL )
+    {
+        /* The ceiling must be the highest priority of all tasks which
+        lock this mutex. */
+        ptNewMutex->uxCeilingPriority = uxCeilingPriority;
     }
     return (OSMutexHandle_t)ptNewMutex;
 }
+#endif //( OS_MUTEX_CEILING_ON!=0 )
 
 #if ( OS_MEMFREE_ON != 0 )
 void OSMutexDelete( OSMutexHandle_t MutexHandle )
@@ -225,28 +256,6 @@ sOSBase_t OSMutexGetID(OSMutexHandle_t const MutexHandle)
     return xID;    
 }
 
-static uOSBase_t OSMutexGetDisinheritPriorityAfterTimeout( OSMutexHandle_t const MutexHandle )
-{
-    uOSBase_t uxHighestPriorityOfWaitingTasks = OSLOWEAST_PRIORITY;
-
-    /* If a task waiting for a mutex causes the mutex holder to inherit a
-    priority, but the waiting task times out, then the holder should
-    disinherit the priority - but only down to the highest priority of any
-    other tasks that are waiting for the same mutex.  For this purpose,
-    return the priority of the highest priority task that is waiting for the
-    mutex. */
-    if( OSListGetLength( &( MutexHandle->tTaskListEventMutexP ) ) > 0 )
-    {
-        uxHighestPriorityOfWaitingTasks = OSHIGHEAST_PRIORITY - OSlistGetHeadItemValue( &( MutexHandle->tTaskListEventMutexP ) );
-    }
-    else
-    {
-        uxHighestPriorityOfWaitingTasks = OSLOWEAST_PRIORITY;
-    }
-
-    return uxHighestPriorityOfWaitingTasks;
-}
-    
 uOSBool_t OSMutexLock( OSMutexHandle_t MutexHandle, uOSTick_t uxTicksToWait )
 {
     uOSBool_t bEntryTimeSet = OS_FALSE;
@@ -270,9 +279,18 @@ uOSBool_t OSMutexLock( OSMutexHandle_t MutexHandle, uOSTick_t uxTicksToWait )
             if( uxCurNum > ( uOSBase_t ) 0 )
             {
                 ptMutex->uxCurNum = uxCurNum - 1;
-                ptMutex->MutexHolderHandle = ( sOS8_t * ) OSTaskGetMutexHolder();
+                ptMutex->MutexHolderHandle = ( sOS8_t * ) OSTaskGetMutexHolder( ( void * ) ptMutex );
                 //mutex locked successfully
                 ( ptMutex->uxMutexLocked )++;
+
+                #if ( OS_MUTEX_CEILING_ON!=0 )
+                if( ptMutex->uxCeilingPriority != MUTEX_NO_CEILING )
+                {
+                    /* Raise the holder to the ceiling immediately, the running
+                    task is never preempted by this so no schedule is needed. */
+                    OSTaskPriorityCeiling( ( void * ) ptMutex->MutexHolderHandle, ptMutex->uxCeilingPriority );
+                }
+                #endif //( OS_MUTEX_CEILING_ON!=0 )
                                 
                 if( OSListIsEmpty( &( ptMutex->tTaskListEventMutexV ) ) == OS_FALSE )
                 {
@@ -313,7 +331,7 @@ uOSBool_t OSMutexLock( OSMutexHandle_t MutexHandle, uOSTick_t uxTicksToWait )
             {
                 OSIntLock();
                 {
-                    bInheritanceOccurred = OSTaskPriorityInherit( ( void * ) ptMutex->MutexHolderHandle );
+                    bInheritanceOccurred = OSTaskPriorityInherit( ( void * ) ptMutex );
                 }
                 OSIntUnlock();
                 
@@ -342,15 +360,12 @@ uOSBool_t OSMutexLock( OSMutexHandle_t MutexHandle, uOSTick_t uxTicksToWait )
                 {
                     OSIntLock();
                     {
-                        uOSBase_t uxHighestWaitingPriority;
-
                         /* This task blocking on the mutex caused another
                         task to inherit this task's priority.  Now this task
                         has timed out the priority should be disinherited
-                        again, but only as low as the next highest priority
-                        task that is waiting for the same mutex. */
-                        uxHighestWaitingPriority = OSMutexGetDisinheritPriorityAfterTimeout( ptMutex );
-                        OSTaskPriorityDisinheritAfterTimeout( ( void * ) ptMutex->MutexHolderHandle, uxHighestWaitingPriority );
+                        again, but only as low as the highest priority task
+                        still waiting for any mutex held along the chain. */
+                        OSTaskPriorityDisinheritAfterTimeout( ( void * ) ptMutex->MutexHolderHandle );
                     }
                     OSIntUnlock();
                 }
@@ -393,8 +408,9 @@ uOSBool_t OSMutexUnlock( OSMutexHandle_t MutexHandle )
 
             if( uxCurNum < ptMutex->uxMaxNum )
             {
-                /* The mutex is no longer being held. */
-                bNeedSchedule = OSTaskPriorityDisinherit( ( void * ) ptMutex->MutexHolderHandle );
+                /* The mutex is no longer being held, the holder drops to the
+                highest priority required by the mutexes it still holds. */
+                bNeedSchedule = OSTaskPriorityDisinherit( ( void * ) ptMutex->MutexHolderHandle, ( void * ) ptMutex );
                 ptMutex->MutexHolderHandle = OS_NULL;
                 ptMutex->uxCurNum = uxCurNum + 1;
 
@@ -62,12 +62,21 @@ typedef struct tOSMutex
     volatile sOSBase_t          xMutexPLock;            // Record the number of task which lock from the mutex while it was locked.
     volatile sOSBase_t          xMutexVLock;            // Record the number of task which unlock to the mutex while it was locked.
 
+    struct tOSMutex *           ptNextHoldMutex;        // Next mutex held by the same task.
+
+#if ( OS_MUTEX_CEILING_ON!=0 )
+    uOSBase_t                   uxCeilingPriority;      // Priority ceiling of the mutex, OSHIGHEAST_PRIORITY means no ceiling.
+#endif //( OS_MUTEX_CEILING_ON!=0 )
+
     sOSBase_t                   xID;
 } tOSMutex_t;
 
 typedef    tOSMutex_t*          OSMutexHandle_t;
 
 OSMutexHandle_t   OSMutexCreate( void ) TINIUX_FUNCTION;
+#if ( OS_MUTEX_CEILING_ON!=0 )
+OSMutexHandle_t   OSMutexCreateCeiling( uOSBase_t uxCeilingPriority ) TINIUX_FUNCTION;
+#endif //( OS_MUTEX_CEILING_ON!=0 )
 #if ( OS_MEMFREE_ON != 0 )
 void              OSMutexDelete( OSMutexHandle_t MutexHandle ) TINIUX_FUNCTION;
 #endif /* OS_MEMFREE_ON */
@@ -0,0 +1,401 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#include <string.h>
+
+#include "TINIUX.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( OS_PRIO_MSGQ_ON!=0 )
+
+#define OSPrioMsgQItem( ptMsgQ, uxPriority, uxIndex )    \
+    ( ( ptMsgQ )->pcItems + ( ( ( uxPriority ) * ( ptMsgQ )->uxMaxNum ) + ( uxIndex ) ) * ( ptMsgQ )->uxItemSize )
+
+static uOSBase_t OSPrioMsgQTopPriority( const tOSPrioMsgQ_t * const ptMsgQ )
+{
+    /* THIS FUNCTION MUST BE CALLED WITH THE INTERRUPT LOCKED AND THE QUEUE NOT EMPTY. */
+    uOSBase_t uxTopPriority = ptMsgQ->uxPrioNum - 1U;
+
+#if ( FITQUICK_GET_PRIORITY == 1U )
+    FitGET_HIGHEST_PRIORITY( uxTopPriority, ptMsgQ->uiPrioMask );
+#else
+    while( ( ptMsgQ->uiPrioMask & ( ( uOS32_t ) 1UL << uxTopPriority ) ) == 0UL )
+    {
+        --uxTopPriority;
+    }
+#endif
+
+    return uxTopPriority;
+}
+
+static uOSBool_t OSPrioMsgQPut( tOSPrioMsgQ_t * const ptMsgQ, const void * const pvItemToQueue, uOSBase_t uxPriority )
+{
+    /* THIS FUNCTION MUST BE CALLED WITH THE INTERRUPT LOCKED. */
+    tOSPrioMsgQRing_t * const ptRing = &( ptMsgQ->ptRing[ uxPriority ] );
+    uOSBase_t uxIndex = ( uOSBase_t ) 0U;
+
+    if( ptRing->uxCurNum >= ptMsgQ->uxMaxNum )
+    {
+        return OS_FALSE;
+    }
+
+    uxIndex = ptRing->uxHead + ptRing->uxCurNum;
+    if( uxIndex >= ptMsgQ->uxMaxNum )
+    {
+        uxIndex -= ptMsgQ->uxMaxNum;
+    }
+    ( void ) memcpy( ( void * ) OSPrioMsgQItem( ptMsgQ, uxPriority, uxIndex ), pvItemToQueue, ( size_t ) ptMsgQ->uxItemSize );
+
+    ( ptRing->uxCurNum )++;
+    ( ptMsgQ->uxCurNum )++;
+    ptMsgQ->uiPrioMask |= ( ( uOS32_t ) 1UL << uxPriority );
+
+    return OS_TRUE;
+}
+
+static uOSBase_t OSPrioMsgQGet( tOSPrioMsgQ_t * const ptMsgQ, void * const pvBuffer )
+{
+    /* THIS FUNCTION MUST BE CALLED WITH THE INTERRUPT LOCKED AND THE QUEUE NOT EMPTY. */
+    const uOSBase_t uxPriority = OSPrioMsgQTopPriority( ptMsgQ );
+    tOSPrioMsgQRing_t * const ptRing = &( ptMsgQ->ptRing[ uxPriority ] );
+
+    ( void ) memcpy( pvBuffer, ( void * ) OSPrioMsgQItem( ptMsgQ, uxPriority, ptRing->uxHead ), ( size_t ) ptMsgQ->uxItemSize );
+
+    ( ptRing->uxHead )++;
+    if( ptRing->uxHead >= ptMsgQ->uxMaxNum )
+    {
+        ptRing->uxHead = ( uOSBase_t ) 0U;
+    }
+    ( ptRing->uxCurNum )--;
+    ( ptMsgQ->uxCurNum )--;
+    if( ptRing->uxCurNum == ( uOSBase_t ) 0U )
+    {
+        ptMsgQ->uiPrioMask &= ~( ( uOS32_t ) 1UL << uxPriority );
+    }
+
+    return uxPriority;
+}
+
+/* Every priority has its own ring of uxQueueLength messages, so messages
+of one priority never take the room of another. */
+OSPrioMsgQHandle_t OSPrioMsgQCreate( const uOSBase_t uxQueueLength, const uOSBase_t uxItemSize, const uOSBase_t uxPrioNum )
+{
+    tOSPrioMsgQ_t *ptNewMsgQ = OS_NULL;
+    uOSMemSize_t uxRingSize = ( uOSMemSize_t ) 0U;
+    uOSBase_t x = ( uOSBase_t ) 0U;
+
+    if( ( uxQueueLength == ( uOSBase_t ) 0U ) || ( uxPrioNum == ( uOSBase_t ) 0U ) || ( uxPrioNum > ( uOSBase_t ) 32U ) )
+    {
+        return OS_NULL;
+    }
+
+    uxRingSize = ( uOSMemSize_t ) OSMEM_ALIGN_SIZE( sizeof( tOSPrioMsgQRing_t ) * uxPrioNum );
+    ptNewMsgQ = ( tOSPrioMsgQ_t * ) OSMemMalloc( ( uOSMemSize_t ) OSMEM_ALIGN_SIZE( sizeof( tOSPrioMsgQ_t ) ) + uxRingSize + ( uOSMemSize_t ) ( uxQueueLength * uxItemSize * uxPrioNum ) );
+    if( ptNewMsgQ != OS_NULL )
+    {
+        ptNewMsgQ->ptRing = ( tOSPrioMsgQRing_t * ) ( ( uOS8_t * ) ptNewMsgQ + OSMEM_ALIGN_SIZE( sizeof( tOSPrioMsgQ_t ) ) );
+        ptNewMsgQ->pcItems = ( sOS8_t * ) ptNewMsgQ->ptRing + uxRingSize;
+
+        ptNewMsgQ->uiPrioMask = 0UL;
+        ptNewMsgQ->uxCurNum = ( uOSBase_t ) 0U;
+        ptNewMsgQ->uxMaxNum = uxQueueLength;
+        ptNewMsgQ->uxItemSize = uxItemSize;
+        ptNewMsgQ->uxPrioNum = uxPrioNum;
+
+        OSListInit( &( ptNewMsgQ->tTaskListEventMsgQP ) );
+        for( x = ( uOSBase_t ) 0U; x < uxPrioNum; x++ )
+        {
+            ptNewMsgQ->ptRing[ x ].uxHead = ( uOSBase_t ) 0U;
+            ptNewMsgQ->ptRing[ x ].uxCurNum = ( uOSBase_t ) 0U;
+            OSListInit( &( ptNewMsgQ->ptRing[ x ].tTaskListEventMsgQV ) );
+        }
+    }
+    return ( OSPrioMsgQHandle_t ) ptNewMsgQ;
+}
+
+#if ( OS_MEMFREE_ON != 0 )
+void OSPrioMsgQDelete( OSPrioMsgQHandle_t MsgQHandle )
+{
+    tOSPrioMsgQ_t * const ptMsgQ = ( tOSPrioMsgQ_t * ) MsgQHandle;
+
+    OSMemFree( ptMsgQ );
+}
+#endif /* OS_MEMFREE_ON */
+
+sOSBase_t OSPrioMsgQSetID(OSPrioMsgQHandle_t MsgQHandle, sOSBase_t xID)
+{
+    if(MsgQHandle == OS_NULL)
+    {
+        return 1;
+    }
+    OSIntLock();
+    {
+        MsgQHandle->xID = xID;
+    }
+    OSIntUnlock();
+
+    return 0;
+}
+
+sOSBase_t OSPrioMsgQGetID(OSPrioMsgQHandle_t const MsgQHandle)
+{
+    sOSBase_t xID = 0;
+
+    OSIntLock();
+    if(MsgQHandle != OS_NULL)
+    {
+        xID = MsgQHandle->xID;
+    }
+    OSIntUnlock();
+
+    return xID;
+}
+
+/* Waits only while the ring of ucPriority is full. */
+uOSBool_t OSPrioMsgQSend( OSPrioMsgQHandle_t MsgQHandle, const void * const pvItemToQueue, uOS8_t ucPriority, uOSTick_t uxTicksToWait )
+{
+    uOSBool_t bEntryTimeSet = OS_FALSE;
+    tOSTimeOut_t tTimeOut;
+    tOSPrioMsgQ_t * const ptMsgQ = ( tOSPrioMsgQ_t * ) MsgQHandle;
+
+    if( ( uOSBase_t ) ucPriority >= ptMsgQ->uxPrioNum )
+    {
+        return OS_FALSE;
+    }
+
+    for( ;; )
+    {
+        OSIntLock();
+        {
+            if( OSPrioMsgQPut( ptMsgQ, pvItemToQueue, ( uOSBase_t ) ucPriority ) != OS_FALSE )
+            {
+                if( OSListIsEmpty( &( ptMsgQ->tTaskListEventMsgQP ) ) == OS_FALSE )
+                {
+                    if( OSTaskListEventRemove( &( ptMsgQ->tTaskListEventMsgQP ) ) != OS_FALSE )
+                    {
+                        OSSchedule();
+                    }
+                }
+
+                OSIntUnlock();
+                return OS_TRUE;
+            }
+
+            if( uxTicksToWait == ( uOSTick_t ) 0 )
+            {
+                OSIntUnlock();
+                //the ring of the priority is full
+                return OS_FALSE;
+            }
+            else if( bEntryTimeSet == OS_FALSE )
+            {
+                OSSetTimeOutState( &tTimeOut );
+                bEntryTimeSet = OS_TRUE;
+            }
+            else if( OSGetTimeOutState( &tTimeOut, &uxTicksToWait ) != OS_FALSE )
+            {
+                OSIntUnlock();
+                return OS_FALSE;
+            }
+
+            OSTaskListEventAdd( &( ptMsgQ->ptRing[ ucPriority ].tTaskListEventMsgQV ), uxTicksToWait );
+            OSSchedule();
+        }
+        OSIntUnlock();
+    }
+}
+
+uOSBool_t OSPrioMsgQSendFromISR( OSPrioMsgQHandle_t MsgQHandle, const void * const pvItemToQueue, uOS8_t ucPriority )
+{
+    uOSBool_t bReturn = OS_FALSE;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+    tOSPrioMsgQ_t * const ptMsgQ = ( tOSPrioMsgQ_t * ) MsgQHandle;
+
+    uOSBool_t bNeedSchedule = OS_FALSE;
+
+    if( ( uOSBase_t ) ucPriority >= ptMsgQ->uxPrioNum )
+    {
+        return OS_FALSE;
+    }
+
+    uxIntSave = OSIntMaskFromISR();
+    {
+        bReturn = OSPrioMsgQPut( ptMsgQ, pvItemToQueue, ( uOSBase_t ) ucPriority );
+        if( bReturn != OS_FALSE )
+        {
+            if( OSListIsEmpty( &( ptMsgQ->tTaskListEventMsgQP ) ) == OS_FALSE )
+            {
+                if( OSTaskListEventRemoveFromISR( &( ptMsgQ->tTaskListEventMsgQP ) ) != OS_FALSE )
+                {
+                    bNeedSchedule = OS_TRUE;
+                }
+            }
+        }
+    }
+    OSIntUnmaskFromISR( uxIntSave );
+
+    if(SCHEDULER_RUNNING == OSScheduleGetState())
+    {
+        OSScheduleFromISR( bNeedSchedule );
+    }
+
+    return bReturn;
+}
+
+/* Receives the oldest message of the highest priority, its priority is
+returned in pucPriority if it is not OS_NULL. */
+uOSBool_t OSPrioMsgQReceive( OSPrioMsgQHandle_t MsgQHandle, void * const pvBuffer, uOS8_t * const pucPriority, uOSTick_t uxTicksToWait )
+{
+    uOSBool_t bEntryTimeSet = OS_FALSE;
+    tOSTimeOut_t tTimeOut;
+    tOSPrioMsgQ_t * const ptMsgQ = ( tOSPrioMsgQ_t * ) MsgQHandle;
+    tOSList_t * ptSendList = OS_NULL;
+    uOSBase_t uxPriority = ( uOSBase_t ) 0U;
+
+    for( ;; )
+    {
+        OSIntLock();
+        {
+            if( ptMsgQ->uxCurNum > ( uOSBase_t ) 0U )
+            {
+                uxPriority = OSPrioMsgQGet( ptMsgQ, pvBuffer );
+                if( pucPriority != OS_NULL )
+                {
+                    *pucPriority = ( uOS8_t ) uxPriority;
+                }
+
+                /* Only a sender of the same priority can use the room. */
+                ptSendList = &( ptMsgQ->ptRing[ uxPriority ].tTaskListEventMsgQV );
+                if( OSListIsEmpty( ptSendList ) == OS_FALSE )
+                {
+                    if( OSTaskListEventRemove( ptSendList ) != OS_FALSE )
+                    {
+                        OSSchedule();
+                    }
+                }
+
+                OSIntUnlock();
+                return OS_TRUE;
+            }
+
+            if( uxTicksToWait == ( uOSTick_t ) 0 )
+            {
+                OSIntUnlock();
+                //the queue is empty
+                return OS_FALSE;
+            }
+            else if( bEntryTimeSet == OS_FALSE )
+            {
+                OSSetTimeOutState( &tTimeOut );
+                bEntryTimeSet = OS_TRUE;
+            }
+            else if( OSGetTimeOutState( &tTimeOut, &uxTicksToWait ) != OS_FALSE )
+            {
+                OSIntUnlock();
+                return OS_FALSE;
+            }
+
+            OSTaskListEventAdd( &( ptMsgQ->tTaskListEventMsgQP ), uxTicksToWait );
+            OSSchedule();
+        }
+        OSIntUnlock();
+    }
+}
+
+uOSBool_t OSPrioMsgQReceiveFromISR( OSPrioMsgQHandle_t MsgQHandle, void * const pvBuffer, uOS8_t * const pucPriority )
+{
+    uOSBool_t bReturn = OS_FALSE;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+    tOSPrioMsgQ_t * const ptMsgQ = ( tOSPrioMsgQ_t * ) MsgQHandle;
+    tOSList_t * ptSendList = OS_NULL;
+    uOSBase_t uxPriority = ( uOSBase_t ) 0U;
+
+    uOSBool_t bNeedSchedule = OS_FALSE;
+
+    uxIntSave = OSIntMaskFromISR();
+    {
+        if( ptMsgQ->uxCurNum > ( uOSBase_t ) 0U )
+        {
+            uxPriority = OSPrioMsgQGet( ptMsgQ, pvBuffer );
+            if( pucPriority != OS_NULL )
+            {
+                *pucPriority = ( uOS8_t ) uxPriority;
+            }
+
+            ptSendList = &( ptMsgQ->ptRing[ uxPriority ].tTaskListEventMsgQV );
+            if( OSListIsEmpty( ptSendList ) == OS_FALSE )
+            {
+                if( OSTaskListEventRemoveFromISR( ptSendList ) != OS_FALSE )
+                {
+                    bNeedSchedule = OS_TRUE;
+                }
+            }
+
+            bReturn = OS_TRUE;
+        }
+    }
+    OSIntUnmaskFromISR( uxIntSave );
+
+    if(SCHEDULER_RUNNING == OSScheduleGetState())
+    {
+        OSScheduleFromISR( bNeedSchedule );
+    }
+
+    return bReturn;
+}
+
+uOSBase_t OSPrioMsgQGetMsgNum( const OSPrioMsgQHandle_t MsgQHandle )
+{
+    uOSBase_t uxReturn = ( uOSBase_t ) 0U;
+
+    OSIntLock();
+    {
+        uxReturn = ( ( tOSPrioMsgQ_t * ) MsgQHandle )->uxCurNum;
+    }
+    OSIntUnlock();
+
+    return uxReturn;
+}
+
+#endif //( OS_PRIO_MSGQ_ON!=0 )
+
+#ifdef __cplusplus
+}
+#endif
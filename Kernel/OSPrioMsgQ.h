@@ -0,0 +1,98 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#ifndef __OS_PRIO_MSGQ_H_
+#define __OS_PRIO_MSGQ_H_
+
+#include "OSType.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( OS_PRIO_MSGQ_ON!=0 )
+
+typedef struct tOSPrioMsgQRing
+{
+    tOSList_t                   tTaskListEventMsgQV;   // Send TaskList of the priority;
+    uOSBase_t                   uxHead;
+    volatile uOSBase_t          uxCurNum;
+} tOSPrioMsgQRing_t;
+
+typedef struct tOSPrioMsgQ
+{
+    char                        pcMsgQName[ OSNAME_MAX_LEN ];
+
+    sOS8_t *                    pcItems;                // The rings of all the priorities, lowest priority first.
+    tOSPrioMsgQRing_t *         ptRing;
+
+    tOSList_t                   tTaskListEventMsgQP;   // Recv TaskList;
+
+    volatile uOS32_t            uiPrioMask;             // One bit for each priority with messages.
+    volatile uOSBase_t          uxCurNum;
+    uOSBase_t                   uxMaxNum;               // Length of the ring of each priority.
+    uOSBase_t                   uxItemSize;
+    uOSBase_t                   uxPrioNum;
+
+    sOSBase_t                   xID;
+} tOSPrioMsgQ_t;
+
+typedef tOSPrioMsgQ_t*          OSPrioMsgQHandle_t;
+
+OSPrioMsgQHandle_t OSPrioMsgQCreate( const uOSBase_t uxQueueLength, const uOSBase_t uxItemSize, const uOSBase_t uxPrioNum ) TINIUX_FUNCTION;
+#if ( OS_MEMFREE_ON != 0 )
+void              OSPrioMsgQDelete( OSPrioMsgQHandle_t MsgQHandle ) TINIUX_FUNCTION;
+#endif /* OS_MEMFREE_ON */
+
+sOSBase_t         OSPrioMsgQSetID(OSPrioMsgQHandle_t MsgQHandle, sOSBase_t xID) TINIUX_FUNCTION;
+sOSBase_t         OSPrioMsgQGetID(OSPrioMsgQHandle_t const MsgQHandle) TINIUX_FUNCTION;
+
+uOSBool_t         OSPrioMsgQSend( OSPrioMsgQHandle_t MsgQHandle, const void * const pvItemToQueue, uOS8_t ucPriority, uOSTick_t uxTicksToWait) TINIUX_FUNCTION;
+uOSBool_t         OSPrioMsgQSendFromISR( OSPrioMsgQHandle_t MsgQHandle, const void * const pvItemToQueue, uOS8_t ucPriority) TINIUX_FUNCTION;
+
+uOSBool_t         OSPrioMsgQReceive( OSPrioMsgQHandle_t MsgQHandle, void * const pvBuffer, uOS8_t * const pucPriority, uOSTick_t uxTicksToWait) TINIUX_FUNCTION;
+uOSBool_t         OSPrioMsgQReceiveFromISR( OSPrioMsgQHandle_t MsgQHandle, void * const pvBuffer, uOS8_t * const pucPriority) TINIUX_FUNCTION;
+
+uOSBase_t         OSPrioMsgQGetMsgNum( const OSPrioMsgQHandle_t MsgQHandle ) TINIUX_FUNCTION;
+
+#endif //( OS_PRIO_MSGQ_ON!=0 )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__OS_PRIO_MSGQ_H_
@@ -0,0 +1,444 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#include "TINIUX.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( OS_RWLOCK_ON!=0 )
+
+static uOSBool_t OSRWLockCanRead( OSRWLockHandle_t RWLockHandle )
+{
+    uOSBool_t bReturn = OS_FALSE;
+    tOSRWLock_t * const ptRWLock = ( tOSRWLock_t * ) RWLockHandle;
+
+    /* Writer preference: a waiting writer holds back new readers. */
+    OSIntLock();
+    {
+        if( ( ptRWLock->RWLockWriterHandle == OS_NULL ) && ( ptRWLock->uxWriterWaitNum == ( uOSBase_t ) 0U ) )
+        {
+            bReturn = OS_TRUE;
+        }
+        else
+        {
+            bReturn = OS_FALSE;
+        }
+    }
+    OSIntUnlock();
+
+    return bReturn;
+}
+
+static uOSBool_t OSRWLockCanWrite( OSRWLockHandle_t RWLockHandle )
+{
+    uOSBool_t bReturn = OS_FALSE;
+    tOSRWLock_t * const ptRWLock = ( tOSRWLock_t * ) RWLockHandle;
+
+    OSIntLock();
+    {
+        if( ( ptRWLock->RWLockWriterHandle == OS_NULL ) && ( ptRWLock->uxReaderNum == ( uOSBase_t ) 0U ) )
+        {
+            bReturn = OS_TRUE;
+        }
+        else
+        {
+            bReturn = OS_FALSE;
+        }
+    }
+    OSIntUnlock();
+
+    return bReturn;
+}
+
+static uOSBool_t OSRWLockWakeUp( tOSRWLock_t * const ptRWLock )
+{
+    /* THIS FUNCTION MUST BE CALLED WITH THE INTERRUPT LOCKED. */
+    uOSBool_t bNeedSchedule = OS_FALSE;
+
+    /* Wake the highest priority writer first, all readers are woken only
+    when no writer is waiting. */
+    if( OSListIsEmpty( &( ptRWLock->tTaskListEventWrite ) ) == OS_FALSE )
+    {
+        if( OSTaskListEventRemove( &( ptRWLock->tTaskListEventWrite ) ) != OS_FALSE )
+        {
+            bNeedSchedule = OS_TRUE;
+        }
+    }
+    else if( ptRWLock->uxWriterWaitNum == ( uOSBase_t ) 0U )
+    {
+        while( OSListIsEmpty( &( ptRWLock->tTaskListEventRead ) ) == OS_FALSE )
+        {
+            if( OSTaskListEventRemove( &( ptRWLock->tTaskListEventRead ) ) != OS_FALSE )
+            {
+                bNeedSchedule = OS_TRUE;
+            }
+        }
+    }
+
+    return bNeedSchedule;
+}
+
+OSRWLockHandle_t OSRWLockCreate( void )
+{
+    tOSRWLock_t *ptNewRWLock = OS_NULL;
+
+    ptNewRWLock = ( tOSRWLock_t * ) OSMemMalloc( sizeof( tOSRWLock_t ) );
+    if( ptNewRWLock != OS_NULL )
+    {
+        ptNewRWLock->RWLockWriterHandle = OS_NULL;
+        ptNewRWLock->ptNextHoldRWLock = OS_NULL;
+
+        ptNewRWLock->uxReaderNum = ( uOSBase_t ) 0U;
+        ptNewRWLock->uxWriterWaitNum = ( uOSBase_t ) 0U;
+
+        /* Ensure the event queues start with the correct state. */
+        OSListInit( &( ptNewRWLock->tTaskListEventRead ) );
+        OSListInit( &( ptNewRWLock->tTaskListEventWrite ) );
+    }
+    return (OSRWLockHandle_t)ptNewRWLock;
+}
+
+#if ( OS_MEMFREE_ON != 0 )
+void OSRWLockDelete( OSRWLockHandle_t RWLockHandle )
+{
+    tOSRWLock_t * const ptRWLock = ( tOSRWLock_t * ) RWLockHandle;
+
+    OSMemFree( ptRWLock );
+}
+#endif /* OS_MEMFREE_ON */
+
+sOSBase_t OSRWLockSetID(OSRWLockHandle_t RWLockHandle, sOSBase_t xID)
+{
+    if(RWLockHandle == OS_NULL)
+    {
+        return 1;
+    }
+    OSIntLock();
+    {
+        RWLockHandle->xID = xID;
+    }
+    OSIntUnlock();
+
+    return 0;
+}
+
+sOSBase_t OSRWLockGetID(OSRWLockHandle_t const RWLockHandle)
+{
+    sOSBase_t xID = 0;
+
+    OSIntLock();
+    if(RWLockHandle != OS_NULL)
+    {
+        xID = RWLockHandle->xID;
+    }
+    OSIntUnlock();
+
+    return xID;
+}
+
+uOSBool_t OSRWLockReadLock( OSRWLockHandle_t RWLockHandle, uOSTick_t uxTicksToWait )
+{
+    uOSBool_t bEntryTimeSet = OS_FALSE;
+    tOSTimeOut_t tTimeOut;
+    tOSRWLock_t * const ptRWLock = ( tOSRWLock_t * ) RWLockHandle;
+#if ( OS_MUTEX_ON!=0 )
+    uOSBool_t bInheritanceOccurred = OS_FALSE;
+#endif //( OS_MUTEX_ON!=0 )
+
+    for( ;; )
+    {
+        OSIntLock();
+        {
+            if( ( ptRWLock->RWLockWriterHandle == OS_NULL ) && ( ptRWLock->uxWriterWaitNum == ( uOSBase_t ) 0U ) )
+            {
+                ( ptRWLock->uxReaderNum )++;
+
+                OSIntUnlock();
+                return OS_TRUE;
+            }
+            else
+            {
+                if( uxTicksToWait == ( uOSTick_t ) 0 )
+                {
+                    OSIntUnlock();
+                    return OS_FALSE;
+                }
+                else if( bEntryTimeSet == OS_FALSE )
+                {
+                    OSSetTimeOutState( &tTimeOut );
+                    bEntryTimeSet = OS_TRUE;
+                }
+            }
+        }
+        OSIntUnlock();
+
+        /* The RW lock is only used by tasks, locking the scheduler is enough
+        to keep its state until this task is in the event list. */
+        OSScheduleLock();
+
+        if( OSGetTimeOutState( &tTimeOut, &uxTicksToWait ) == OS_FALSE )
+        {
+            if( OSRWLockCanRead( ptRWLock ) == OS_FALSE )
+            {
+                #if ( OS_MUTEX_ON!=0 )
+                {
+                    OSIntLock();
+                    {
+                        if( OSTaskPriorityInheritRWLock( ( void * ) ptRWLock->RWLockWriterHandle ) != OS_FALSE )
+                        {
+                            bInheritanceOccurred = OS_TRUE;
+                        }
+                    }
+                    OSIntUnlock();
+                }
+                #endif //( OS_MUTEX_ON!=0 )
+
+                OSTaskListEventAdd( &( ptRWLock->tTaskListEventRead ), uxTicksToWait );
+                if( OSScheduleUnlock() == OS_FALSE )
+                {
+                    OSSchedule();
+                }
+            }
+            else
+            {
+                /* Try again. */
+                ( void ) OSScheduleUnlock();
+            }
+        }
+        else
+        {
+            ( void ) OSScheduleUnlock();
+
+            if( OSRWLockCanRead( ptRWLock ) == OS_FALSE )
+            {
+                #if ( OS_MUTEX_ON!=0 )
+                if( bInheritanceOccurred != OS_FALSE )
+                {
+                    OSIntLock();
+                    {
+                        OSTaskPriorityDisinheritAfterTimeout( ( void * ) ptRWLock->RWLockWriterHandle );
+                    }
+                    OSIntUnlock();
+                }
+                #endif //( OS_MUTEX_ON!=0 )
+
+                return OS_FALSE;
+            }
+        }
+    }
+}
+
+uOSBool_t OSRWLockReadUnlock( OSRWLockHandle_t RWLockHandle )
+{
+    tOSRWLock_t * const ptRWLock = ( tOSRWLock_t * ) RWLockHandle;
+    uOSBool_t bReturn = OS_FALSE;
+
+    OSIntLock();
+    {
+        if( ptRWLock->uxReaderNum > ( uOSBase_t ) 0U )
+        {
+            ( ptRWLock->uxReaderNum )--;
+
+            /* The last reader hands the lock over to the waiting writer. */
+            if( ptRWLock->uxReaderNum == ( uOSBase_t ) 0U )
+            {
+                if( OSRWLockWakeUp( ptRWLock ) != OS_FALSE )
+                {
+                    OSSchedule();
+                }
+            }
+            bReturn = OS_TRUE;
+        }
+    }
+    OSIntUnlock();
+
+    return bReturn;
+}
+
+uOSBool_t OSRWLockWriteLock( OSRWLockHandle_t RWLockHandle, uOSTick_t uxTicksToWait )
+{
+    uOSBool_t bEntryTimeSet = OS_FALSE;
+    tOSTimeOut_t tTimeOut;
+    tOSRWLock_t * const ptRWLock = ( tOSRWLock_t * ) RWLockHandle;
+#if ( OS_MUTEX_ON!=0 )
+    uOSBool_t bInheritanceOccurred = OS_FALSE;
+#endif //( OS_MUTEX_ON!=0 )
+
+    for( ;; )
+    {
+        OSIntLock();
+        {
+            if( ( ptRWLock->RWLockWriterHandle == OS_NULL ) && ( ptRWLock->uxReaderNum == ( uOSBase_t ) 0U ) )
+            {
+                #if ( OS_MUTEX_ON!=0 )
+                ptRWLock->RWLockWriterHandle = ( sOS8_t * ) OSTaskGetRWLockWriter( ( void * ) ptRWLock );
+                #else
+                ptRWLock->RWLockWriterHandle = ( sOS8_t * ) OSGetCurrentTaskHandle();
+                #endif //( OS_MUTEX_ON!=0 )
+
+                if( bEntryTimeSet != OS_FALSE )
+                {
+                    ( ptRWLock->uxWriterWaitNum )--;
+                }
+
+                OSIntUnlock();
+                return OS_TRUE;
+            }
+            else
+            {
+                if( uxTicksToWait == ( uOSTick_t ) 0 )
+                {
+                    OSIntUnlock();
+                    return OS_FALSE;
+                }
+                else if( bEntryTimeSet == OS_FALSE )
+                {
+                    OSSetTimeOutState( &tTimeOut );
+                    bEntryTimeSet = OS_TRUE;
+
+                    /* From now on new readers wait behind this writer. */
+                    ( ptRWLock->uxWriterWaitNum )++;
+                }
+            }
+        }
+        OSIntUnlock();
+
+        OSScheduleLock();
+
+        if( OSGetTimeOutState( &tTimeOut, &uxTicksToWait ) == OS_FALSE )
+        {
+            if( OSRWLockCanWrite( ptRWLock ) == OS_FALSE )
+            {
+                #if ( OS_MUTEX_ON!=0 )
+                {
+                    OSIntLock();
+                    {
+                        if( OSTaskPriorityInheritRWLock( ( void * ) ptRWLock->RWLockWriterHandle ) != OS_FALSE )
+                        {
+                            bInheritanceOccurred = OS_TRUE;
+                        }
+                    }
+                    OSIntUnlock();
+                }
+                #endif //( OS_MUTEX_ON!=0 )
+
+                OSTaskListEventAdd( &( ptRWLock->tTaskListEventWrite ), uxTicksToWait );
+                if( OSScheduleUnlock() == OS_FALSE )
+                {
+                    OSSchedule();
+                }
+            }
+            else
+            {
+                /* Try again. */
+                ( void ) OSScheduleUnlock();
+            }
+        }
+        else
+        {
+            if( OSRWLockCanWrite( ptRWLock ) == OS_FALSE )
+            {
+                OSIntLock();
+                {
+                    /* Release the readers held back by this writer. */
+                    ( ptRWLock->uxWriterWaitNum )--;
+                    if( ptRWLock->RWLockWriterHandle == OS_NULL )
+                    {
+                        ( void ) OSRWLockWakeUp( ptRWLock );
+                    }
+
+                    #if ( OS_MUTEX_ON!=0 )
+                    if( bInheritanceOccurred != OS_FALSE )
+                    {
+                        OSTaskPriorityDisinheritAfterTimeout( ( void * ) ptRWLock->RWLockWriterHandle );
+                    }
+                    #endif //( OS_MUTEX_ON!=0 )
+                }
+                OSIntUnlock();
+
+                ( void ) OSScheduleUnlock();
+                return OS_FALSE;
+            }
+
+            ( void ) OSScheduleUnlock();
+        }
+    }
+}
+
+uOSBool_t OSRWLockWriteUnlock( OSRWLockHandle_t RWLockHandle )
+{
+    tOSRWLock_t * const ptRWLock = ( tOSRWLock_t * ) RWLockHandle;
+    uOSBool_t bNeedSchedule = OS_FALSE;
+
+    /* The calling task is not the writer, the lock cannot be unlocked here. */
+    if( ptRWLock->RWLockWriterHandle != ( void * ) OSGetCurrentTaskHandle() )
+    {
+        return OS_FALSE;
+    }
+
+    OSIntLock();
+    {
+        #if ( OS_MUTEX_ON!=0 )
+        {
+            bNeedSchedule = OSTaskPriorityDisinheritRWLock( ( void * ) ptRWLock->RWLockWriterHandle, ( void * ) ptRWLock );
+        }
+        #endif //( OS_MUTEX_ON!=0 )
+
+        ptRWLock->RWLockWriterHandle = OS_NULL;
+
+        if( OSRWLockWakeUp( ptRWLock ) != OS_FALSE )
+        {
+            bNeedSchedule = OS_TRUE;
+        }
+
+        if( bNeedSchedule != OS_FALSE )
+        {
+            OSSchedule();
+        }
+    }
+    OSIntUnlock();
+
+    return OS_TRUE;
+}
+
+#endif //( OS_RWLOCK_ON!=0 )
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,86 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#ifndef __OS_RWLOCK_H_
+#define __OS_RWLOCK_H_
+
+#include "OSType.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( OS_RWLOCK_ON!=0 )
+
+typedef struct tOSRWLock
+{
+    char                        pcRWLockName[ OSNAME_MAX_LEN ];
+    sOS8_t *                    RWLockWriterHandle;     // The task which holds the lock for writing.
+
+    tOSList_t                   tTaskListEventRead;     // Read lock TaskList;
+    tOSList_t                   tTaskListEventWrite;    // Write lock TaskList;
+
+    volatile uOSBase_t          uxReaderNum;            // Number of tasks which hold the lock for reading.
+    volatile uOSBase_t          uxWriterWaitNum;        // Number of writers waiting, new readers are held back while it is not zero.
+
+    struct tOSRWLock *          ptNextHoldRWLock;       // Next RW lock held for writing by the same task.
+
+    sOSBase_t                   xID;
+} tOSRWLock_t;
+
+typedef    tOSRWLock_t*         OSRWLockHandle_t;
+
+OSRWLockHandle_t  OSRWLockCreate( void ) TINIUX_FUNCTION;
+#if ( OS_MEMFREE_ON != 0 )
+void              OSRWLockDelete( OSRWLockHandle_t RWLockHandle ) TINIUX_FUNCTION;
+#endif /* OS_MEMFREE_ON */
+
+sOSBase_t         OSRWLockSetID(OSRWLockHandle_t RWLockHandle, sOSBase_t xID) TINIUX_FUNCTION;
+sOSBase_t         OSRWLockGetID(OSRWLockHandle_t const RWLockHandle) TINIUX_FUNCTION;
+
+uOSBool_t         OSRWLockReadLock( OSRWLockHandle_t RWLockHandle, uOSTick_t uxTicksToWait ) TINIUX_FUNCTION;
+uOSBool_t         OSRWLockReadUnlock( OSRWLockHandle_t RWLockHandle ) TINIUX_FUNCTION;
+uOSBool_t         OSRWLockWriteLock( OSRWLockHandle_t RWLockHandle, uOSTick_t uxTicksToWait ) TINIUX_FUNCTION;
+uOSBool_t         OSRWLockWriteUnlock( OSRWLockHandle_t RWLockHandle ) TINIUX_FUNCTION;
+
+#endif //( OS_RWLOCK_ON!=0 )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__OS_RWLOCK_H_
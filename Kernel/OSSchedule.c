@@ -42,64 +42,119 @@ extern "C" {
 #endif
 
 #if ( FITQUICK_GET_PRIORITY == 1U )
-    TINIUX_DATA static volatile  uOSBase_t guxTopReadyPriority  = OSLOWEAST_PRIORITY;
+    TINIUX_FAST_DATA static volatile  uOSBase_t guxTopReadyPriority  = OSLOWEAST_PRIORITY;
 #else
     #if ( OSQUICK_GET_PRIORITY != 0U )
+        /* The map gives the highest set bit of a sub priority bitmap, it is
+        built at compile time so it stays in flash. */
+        #define SUBPRI_X4( n )                          n, n, n, n
+        #define SUBPRI_X8( n )                          SUBPRI_X4( n ), SUBPRI_X4( n )
+        #define SUBPRI_X16( n )                         SUBPRI_X8( n ), SUBPRI_X8( n )
+        #define SUBPRI_X32( n )                         SUBPRI_X16( n ), SUBPRI_X16( n )
+        #define SUBPRI_X64( n )                         SUBPRI_X32( n ), SUBPRI_X32( n )
+        #define SUBPRI_X128( n )                        SUBPRI_X64( n ), SUBPRI_X64( n )
+
         #if ( OSQUICK_GET_PRIORITY == 1U )
             #define SUBPRI_MAXNUM                       ( 2 )
-            #define SUBPRI_TOPPRI                       ( 1 )
             #define SUBPRI_MASK_WIDTH                   ( 1 )
             #define SUBPRI_MASK_VALUE                   ( 1 )
-            #define SUBPRI_BITMAP_WIDTH                 ( 2 )
             #define SUBPRI_BITMAP_MAXNUM                ( 4 )
-            #define SUBPRI_BITMAP_TOPBIT                ( 0x02 )
+            #define SUBPRI_BITMAP_INIT                  0, 0, 1, 1
         #else
             #if ( OSQUICK_GET_PRIORITY == 2U )
                 #define SUBPRI_MAXNUM                   ( 4 )
-                #define SUBPRI_TOPPRI                   ( 3 )
                 #define SUBPRI_MASK_WIDTH               ( 2 )
                 #define SUBPRI_MASK_VALUE               ( 3 )
-                #define SUBPRI_BITMAP_WIDTH             ( 4 )
                 #define SUBPRI_BITMAP_MAXNUM            ( 16 )
-                #define SUBPRI_BITMAP_TOPBIT            ( 0x08 )
+                #define SUBPRI_BITMAP_INIT              0, 0, 1, 1, SUBPRI_X4( 2 ), SUBPRI_X8( 3 )
             #else //( OSQUICK_GET_PRIORITY == 3U )
                 #define SUBPRI_MAXNUM                   ( 8 )
-                #define SUBPRI_TOPPRI                   ( 7 )
                 #define SUBPRI_MASK_WIDTH               ( 3 )
                 #define SUBPRI_MASK_VALUE               ( 7 )
-                #define SUBPRI_BITMAP_WIDTH             ( 8 )
                 #define SUBPRI_BITMAP_MAXNUM            ( 256 )
-                #define SUBPRI_BITMAP_TOPBIT            ( 0x80 )
+                #define SUBPRI_BITMAP_INIT              0, 0, 1, 1, SUBPRI_X4( 2 ), SUBPRI_X8( 3 ), SUBPRI_X16( 4 ),    \
+                                                        SUBPRI_X32( 5 ), SUBPRI_X64( 6 ), SUBPRI_X128( 7 )
             #endif
         #endif
-        TINIUX_DATA static uOS8_t gucSubPriorityMap[SUBPRI_BITMAP_MAXNUM];
-        TINIUX_DATA static volatile uOS8_t gucSubPriorityBit[SUBPRI_MAXNUM];
-        TINIUX_DATA static volatile uOS8_t gucSubPriorityGroupBit  = 0U;
+        TINIUX_DATA static uOS8_t const gucSubPriorityMap[SUBPRI_BITMAP_MAXNUM] = { SUBPRI_BITMAP_INIT };
+        TINIUX_FAST_DATA static volatile uOS8_t gucSubPriorityBit[SUBPRI_MAXNUM];
+        TINIUX_FAST_DATA static volatile uOS8_t gucSubPriorityGroupBit  = 0U;
     #else
     //default do nothing
     #endif
 #endif
 
 TINIUX_DATA static volatile  uOSBool_t gbSchedulerRunning       = OS_FALSE;
-TINIUX_DATA static volatile  uOSBase_t guxSchedulerLocked       = ( uOSBase_t ) OS_FALSE;
-TINIUX_DATA static volatile  uOSBool_t gbNeedSchedule           = OS_FALSE;
-TINIUX_DATA static volatile  uOSTick_t guxTickCount             = ( uOSTick_t ) 0U;
-TINIUX_DATA static volatile  sOSBase_t gxOverflowCount          = ( sOSBase_t ) 0U;
-TINIUX_DATA static volatile  uOSBase_t guxPendedTicks           = ( uOSBase_t ) 0U;
-TINIUX_DATA static volatile  uOSTick_t guxNextUnblockTime       = ( uOSTick_t ) 0U;
+TINIUX_FAST_DATA static volatile  uOSBase_t guxSchedulerLocked  = ( uOSBase_t ) OS_FALSE;
+TINIUX_FAST_DATA static volatile  uOSBool_t gbNeedSchedule      = OS_FALSE;
+TINIUX_FAST_DATA static volatile  uOSTick_t guxTickCount        = ( uOSTick_t ) 0U;
+TINIUX_FAST_DATA static volatile  sOSBase_t gxOverflowCount     = ( sOSBase_t ) 0U;
+TINIUX_FAST_DATA static volatile  uOSBase_t guxPendedTicks      = ( uOSBase_t ) 0U;
+TINIUX_FAST_DATA static volatile  uOSTick_t guxNextUnblockTime  = ( uOSTick_t ) 0U;
+
+#if ( OS_INT_PROFILE_ON!=0 )
+TINIUX_DATA static tOSIntProfile_t gtOSIntProfile[ OSINT_PROFILE_NUM ];
+TINIUX_DATA static uOSBase_t guxIntProfileNesting           = ( uOSBase_t ) 0U;
+TINIUX_DATA static void *    gpvIntProfileCaller            = OS_NULL;
+TINIUX_DATA static uOS32_t   guiIntProfileStart             = ( uOS32_t ) 0U;
+#endif //( OS_INT_PROFILE_ON!=0 )
+
+#if ( OS_BOOT_PROFILE_ON!=0 )
+static void OSBootProfileStage( const char * pcStage, uOS32_t * puiStart )
+{
+    uOS32_t uiNow = OSGetCycleCount();
+
+    OSBootProfileHook( pcStage, uiNow - *puiStart );
+    *puiStart = OSGetCycleCount();
+}
+#define OSBOOT_PROFILE_STAGE( pcStage, uiStart )    OSBootProfileStage( ( pcStage ), &( uiStart ) )
+#else
+#define OSBOOT_PROFILE_STAGE( pcStage, uiStart )
+#endif //( OS_BOOT_PROFILE_ON!=0 )
 
 uOSBase_t OSInit( void )
 {
     uOSBase_t uxReturn = 0;
+#if ( OS_BOOT_PROFILE_ON!=0 )
+    uOS32_t uiInitStart = 0U;
+    uOS32_t uiStageStart = 0U;
+
+    /* The counter is started here already to time the boot, on ports
+    counting with the tick timer it only runs once the scheduler starts. */
+    FitCycleCounterInit();
+    uiInitStart = OSGetCycleCount();
+    uiStageStart = uiInitStart;
+#endif //( OS_BOOT_PROFILE_ON!=0 )
+
+#if ( OS_TCM_PLACEMENT_ON!=0 )
+    /* Load the fast sections before any kernel code runs from them. */
+    FitTCMInit();
+#endif //( OS_TCM_PLACEMENT_ON!=0 )
 
     uxReturn += OSMemInit( );  
+    OSBOOT_PROFILE_STAGE( "OSMemInit", uiStageStart );
     uxReturn += OSScheduleInit( );  
+    OSBOOT_PROFILE_STAGE( "OSScheduleInit", uiStageStart );
     uxReturn += OSTaskInit( );
+    OSBOOT_PROFILE_STAGE( "OSTaskInit", uiStageStart );
     
 #if ( OS_TIMER_ON!=0 )
     uxReturn += OSTimerInit( );
+    OSBOOT_PROFILE_STAGE( "OSTimerInit", uiStageStart );
+#endif
+
+#if ( OS_BASIC_TASK_ON!=0 )
+    uxReturn += OSBasicTaskInit( );
+    OSBOOT_PROFILE_STAGE( "OSBasicTaskInit", uiStageStart );
+#endif
+
+#if ( OS_ACTIVE_ON!=0 )
+    uxReturn += OSActiveInit( );
+    OSBOOT_PROFILE_STAGE( "OSActiveInit", uiStageStart );
 #endif
     
+    OSBOOT_PROFILE_STAGE( "OSInit", uiInitStart );
+
     return uxReturn;
 }
 
@@ -111,24 +166,12 @@ uOSBase_t OSScheduleInit( void )
 #else
 #if ( OSQUICK_GET_PRIORITY != 0U )
     uOS16_t uiSubPriIndex = 0;
-    uOS16_t uiBitIndex = 0;
 
     for (uiSubPriIndex = 0; uiSubPriIndex < SUBPRI_MAXNUM; uiSubPriIndex++)
     {
         gucSubPriorityBit[uiSubPriIndex] = 0;
     }
-    for (uiSubPriIndex = 0; uiSubPriIndex < SUBPRI_BITMAP_MAXNUM; uiSubPriIndex++)
-    {
-        gucSubPriorityMap[uiSubPriIndex] = 0;
-        for (uiBitIndex = 0; uiBitIndex < SUBPRI_BITMAP_WIDTH; uiBitIndex++)
-        {
-            if (((uiSubPriIndex << uiBitIndex) & SUBPRI_BITMAP_TOPBIT) != 0)
-            {
-                gucSubPriorityMap[uiSubPriIndex] = SUBPRI_TOPPRI - uiBitIndex;
-                break;
-            }
-        }
-    }
+    gucSubPriorityGroupBit = 0U;
 #else
     //Default do nothing
 #endif
@@ -149,6 +192,9 @@ uOSBase_t OSStart( void )
 {
     uOSBase_t ReturnValue = (uOSBase_t)0U;
     OSTaskHandle_t TaskHandle = OS_NULL;
+#if ( OS_BOOT_PROFILE_ON!=0 )
+    uOS32_t uiStageStart = OSGetCycleCount();
+#endif //( OS_BOOT_PROFILE_ON!=0 )
 
     TaskHandle = OSTaskCreate(OSIdleTask, OS_NULL, OSMINIMAL_STACK_SIZE, OSLOWEAST_PRIORITY, "OSIdleTask");
     if(TaskHandle != OS_NULL)
@@ -156,11 +202,17 @@ uOSBase_t OSStart( void )
 #if ( OS_TIMER_ON!=0 )
         OSTimerCreateMoniteTask();
 #endif /* ( OS_TIMER_ON!=0 ) */        
+#if ( OS_BASIC_TASK_ON!=0 )
+        OSBasicTaskCreateMoniteTask();
+#endif /* ( OS_BASIC_TASK_ON!=0 ) */
         
         guxNextUnblockTime = OSPEND_FOREVER_VALUE;
         gbSchedulerRunning = OS_TRUE;
         guxTickCount = ( uOSTick_t ) 0U;
 
+        /* Up to the port starting the first task. */
+        OSBOOT_PROFILE_STAGE( "OSStart", uiStageStart );
+
         FitStartScheduler();
     }
     else
@@ -179,12 +231,55 @@ static void OSTickCountOverflow( void )
     OSUpdateUnblockTime();
 }
 
-uOSBool_t OSIncrementTickCount( void )
+/* Move all the tasks pended until uxTickCount or earlier to the ready list. */
+static uOSBool_t OSUnblockExpiredTasks( const uOSTick_t uxTickCount ) TINIUX_FAST_FUNCTION;
+static uOSBool_t OSUnblockExpiredTasks( const uOSTick_t uxTickCount )
 {
     tOSTCB_t * ptTCB = OS_NULL;
     uOSTick_t uxItemValue = (uOSTick_t)0U;
     uOSBool_t bNeedSchedule = OS_FALSE;
 
+    for( ;; )
+    {
+        if( OSTaskListPendNum() == 0U )
+        {
+            guxNextUnblockTime = OSPEND_FOREVER_VALUE;
+            break;
+        }
+        else
+        {
+            ptTCB = ( tOSTCB_t * ) OSTaskListPendHeadItem();
+            uxItemValue = OSListItemGetValue( &( ptTCB->tTaskListItem ) );
+
+            if( uxTickCount < uxItemValue )
+            {
+                guxNextUnblockTime = uxItemValue;
+                break;
+            }
+
+            ( void ) OSListRemoveItem( &( ptTCB->tTaskListItem ) );
+
+            if( OSListItemGetList( &( ptTCB->tEventListItem ) ) != OS_NULL )
+            {
+                ( void ) OSListRemoveItem( &( ptTCB->tEventListItem ) );
+            }
+
+            OSTaskListReadyAdd( ptTCB );
+
+            if( ptTCB->uxPriority >= OSTaskGetMinPreemptPriority() )
+            {
+                bNeedSchedule = OS_TRUE;
+            }
+        }
+    }
+
+    return bNeedSchedule;
+}
+
+uOSBool_t OSIncrementTickCount( void )
+{
+    uOSBool_t bNeedSchedule = OS_FALSE;
+
     if( OSScheduleIsLocked() == OS_FALSE )
     {
         const uOSTick_t uxTickCount = guxTickCount + (uOSTick_t)1;
@@ -197,42 +292,16 @@ uOSBool_t OSIncrementTickCount( void )
 
         if( uxTickCount >= guxNextUnblockTime )
         {
-            for( ;; )
-            {
-                if( OSTaskListPendNum() == 0U )
-                {
-                    guxNextUnblockTime = OSPEND_FOREVER_VALUE;
-                    break;
-                }
-                else
-                {
-                    ptTCB = ( tOSTCB_t * ) OSTaskListPendHeadItem();
-                    uxItemValue = OSListItemGetValue( &( ptTCB->tTaskListItem ) );
-
-                    if( uxTickCount < uxItemValue )
-                    {
-                        guxNextUnblockTime = uxItemValue;
-                        break;
-                    }
-
-                    ( void ) OSListRemoveItem( &( ptTCB->tTaskListItem ) );
-
-                    if( OSListItemGetList( &( ptTCB->tEventListItem ) ) != OS_NULL )
-                    {
-                        ( void ) OSListRemoveItem( &( ptTCB->tEventListItem ) );
-                    }
-
-                    OSTaskListReadyAdd( ptTCB );
-
-                    if( ptTCB->uxPriority >= OSTaskGetPriorityFromISR( OS_NULL ) )
-                    {
-                        bNeedSchedule = OS_TRUE;
-                    }
-                }
-            }
+            bNeedSchedule = OSUnblockExpiredTasks( uxTickCount );
+        }
+        #if ( OS_TASK_BUDGET_ON!=0 )
+        if( OSTaskBudgetCharge( uxTickCount, ( uOSTick_t ) 1U ) != OS_FALSE )
+        {
+            bNeedSchedule = OS_TRUE;
         }
+        #endif //( OS_TASK_BUDGET_ON!=0 )
         #if (OSTIME_SLICE_ON != 0U)
-        if( OSTaskNeedTimeSlice() == OS_TRUE )
+        if( OSTaskNeedTimeSlice( ( uOSTick_t ) 1U ) == OS_TRUE )
         {
             bNeedSchedule = OS_TRUE;
         }
@@ -251,6 +320,57 @@ uOSBool_t OSIncrementTickCount( void )
     return bNeedSchedule;
 }
 
+/* Replay the ticks pended while the scheduler was locked in one step, the
+work done is bound by the tasks expired instead of the ticks elapsed. */
+static uOSBool_t OSAdvanceTickCount( const uOSTick_t uxTicks )
+{
+    const uOSTick_t uxTickCount = guxTickCount + uxTicks;
+    uOSBool_t bNeedSchedule = OS_FALSE;
+
+    if( uxTicks == ( uOSTick_t ) 0U )
+    {
+        return OS_FALSE;
+    }
+
+    if( uxTickCount < guxTickCount )
+    {
+        /* The tick count overflowed on the way, every task pended before the
+        overflow has expired. */
+        if( OSUnblockExpiredTasks( ( uOSTick_t ) ~( uOSTick_t ) 0U ) != OS_FALSE )
+        {
+            bNeedSchedule = OS_TRUE;
+        }
+        guxTickCount = uxTickCount;
+        OSTickCountOverflow();
+    }
+    else
+    {
+        guxTickCount = uxTickCount;
+    }
+
+    if( uxTickCount >= guxNextUnblockTime )
+    {
+        if( OSUnblockExpiredTasks( uxTickCount ) != OS_FALSE )
+        {
+            bNeedSchedule = OS_TRUE;
+        }
+    }
+    #if ( OS_TASK_BUDGET_ON!=0 )
+    if( OSTaskBudgetCharge( uxTickCount, uxTicks ) != OS_FALSE )
+    {
+        bNeedSchedule = OS_TRUE;
+    }
+    #endif //( OS_TASK_BUDGET_ON!=0 )
+    #if (OSTIME_SLICE_ON != 0U)
+    if( OSTaskNeedTimeSlice( uxTicks ) == OS_TRUE )
+    {
+        bNeedSchedule = OS_TRUE;
+    }
+    #endif //(OSTIME_SLICE_ON != 0U)
+
+    return bNeedSchedule;
+}
+
 uOSTick_t OSGetTickCount( void )
 {
     uOSTick_t uxTicks = (uOSTick_t)0U;
@@ -279,6 +399,11 @@ void OSNeedSchedule( void )
     gbNeedSchedule = OS_TRUE;
 }
 
+void OSNeedScheduleClear( void )
+{
+    gbNeedSchedule = OS_FALSE;
+}
+
 void OSScheduleLock( void )
 {
     ++guxSchedulerLocked;
@@ -304,7 +429,7 @@ uOSBool_t OSScheduleUnlock( void )
                     ( void ) OSListRemoveItem( &( ptTCB->tTaskListItem ) );
                     OSTaskListReadyAdd( ptTCB );
 
-                    if( ptTCB->uxPriority >= OSTaskGetPriority( OS_NULL ) )
+                    if( ptTCB->uxPriority >= OSTaskGetMinPreemptPriority() )
                     {
                         gbNeedSchedule = OS_TRUE;
                     }
@@ -314,18 +439,11 @@ uOSBool_t OSScheduleUnlock( void )
                     OSUpdateUnblockTime();
                 }
 
+                if( OSAdvanceTickCount( ( uOSTick_t ) guxPendedTicks ) != OS_FALSE )
                 {
-                    uOSBase_t uxPendedTicks = guxPendedTicks;
-                    while( uxPendedTicks > ( uOSBase_t ) 0U )
-                    {
-                        if( OSIncrementTickCount() != OS_FALSE )
-                        {
-                            gbNeedSchedule = OS_TRUE;
-                        }
-                        --uxPendedTicks;
-                    }
-                    guxPendedTicks = 0;
+                    gbNeedSchedule = OS_TRUE;
                 }
+                guxPendedTicks = 0;
 
                 if( gbNeedSchedule != OS_FALSE )
                 {
@@ -553,6 +671,170 @@ uOSBase_t OSGetTopReadyPriority( void )
     return uxTopPriority;
 }
 
+#if ( OS_INT_PROFILE_ON!=0 )
+/* Called with interrupts masked, only the outermost section is measured. */
+static void OSIntProfileEnter( void * pvCaller )
+{
+    /* Nest first, the cycle counter of a port may mask interrupts itself. */
+    guxIntProfileNesting++;
+    if( guxIntProfileNesting == ( uOSBase_t ) 1U )
+    {
+        gpvIntProfileCaller = pvCaller;
+        guiIntProfileStart = OSGetCycleCount();
+    }
+}
+
+static void OSIntProfileExit( void )
+{
+    uOS32_t uiCycles = ( uOS32_t ) 0U;
+    uOSBase_t uxSlot = ( uOSBase_t ) 0U;
+    uOSBase_t x = ( uOSBase_t ) 0U;
+
+    if( guxIntProfileNesting != ( uOSBase_t ) 1U )
+    {
+        guxIntProfileNesting--;
+        return;
+    }
+
+    /* Read the counter while still nested, see OSIntProfileEnter. */
+    uiCycles = OSGetCycleCount() - guiIntProfileStart;
+    guxIntProfileNesting--;
+
+    /* Update the entry of the call site, or take the free or the shortest one. */
+    for( x = ( uOSBase_t ) 0U; x < ( uOSBase_t ) OSINT_PROFILE_NUM; x++ )
+    {
+        if( gtOSIntProfile[ x ].pvCaller == gpvIntProfileCaller )
+        {
+            gtOSIntProfile[ x ].uiCount++;
+            if( uiCycles > gtOSIntProfile[ x ].uiMaxCycles )
+            {
+                gtOSIntProfile[ x ].uiMaxCycles = uiCycles;
+            }
+            return;
+        }
+        if( gtOSIntProfile[ uxSlot ].pvCaller == OS_NULL )
+        {
+            continue;
+        }
+        if( ( gtOSIntProfile[ x ].pvCaller == OS_NULL ) || ( gtOSIntProfile[ x ].uiMaxCycles < gtOSIntProfile[ uxSlot ].uiMaxCycles ) )
+        {
+            uxSlot = x;
+        }
+    }
+
+    if( ( gtOSIntProfile[ uxSlot ].pvCaller == OS_NULL ) || ( uiCycles > gtOSIntProfile[ uxSlot ].uiMaxCycles ) )
+    {
+        gtOSIntProfile[ uxSlot ].pvCaller = gpvIntProfileCaller;
+        gtOSIntProfile[ uxSlot ].uiMaxCycles = uiCycles;
+        gtOSIntProfile[ uxSlot ].uiCount = ( uOS32_t ) 1U;
+    }
+}
+
+void OSIntProfileLock( void )
+{
+    void * pvCaller = FitGetReturnAddress();
+
+    FitIntLock();
+    OSIntProfileEnter( pvCaller );
+}
+
+void OSIntProfileUnlock( void )
+{
+    OSIntProfileExit();
+    FitIntUnlock();
+}
+
+uOSBase_t OSIntProfileMaskFromISR( void )
+{
+    void * pvCaller = FitGetReturnAddress();
+    uOSBase_t uxIntSave = ( uOSBase_t ) 0U;
+
+    uxIntSave = ( uOSBase_t ) FitIntMaskFromISR();
+    OSIntProfileEnter( pvCaller );
+
+    return uxIntSave;
+}
+
+void OSIntProfileUnmaskFromISR( uOSBase_t uxIntSave )
+{
+    OSIntProfileExit();
+    FitIntUnmaskFromISR( uxIntSave );
+}
+
+/* Copy the profiled call sites out, the longest masked section first. */
+uOSBase_t OSIntProfileGet( tOSIntProfile_t * const ptProfile, uOSBase_t uxMaxNum )
+{
+    tOSIntProfile_t atProfile[ OSINT_PROFILE_NUM ];
+    tOSIntProfile_t tTemp;
+    uOSBase_t uxNum = ( uOSBase_t ) 0U;
+    uOSBase_t x = ( uOSBase_t ) 0U;
+    uOSBase_t y = ( uOSBase_t ) 0U;
+
+    /* The profiler itself is not profiled. */
+    FitIntLock();
+    {
+        for( x = ( uOSBase_t ) 0U; x < ( uOSBase_t ) OSINT_PROFILE_NUM; x++ )
+        {
+            if( gtOSIntProfile[ x ].pvCaller != OS_NULL )
+            {
+                atProfile[ uxNum++ ] = gtOSIntProfile[ x ];
+            }
+        }
+    }
+    FitIntUnlock();
+
+    for( x = ( uOSBase_t ) 1U; x < uxNum; x++ )
+    {
+        tTemp = atProfile[ x ];
+        for( y = x; ( y > ( uOSBase_t ) 0U ) && ( atProfile[ y - 1U ].uiMaxCycles < tTemp.uiMaxCycles ); y-- )
+        {
+            atProfile[ y ] = atProfile[ y - 1U ];
+        }
+        atProfile[ y ] = tTemp;
+    }
+
+    if( uxNum > uxMaxNum )
+    {
+        uxNum = uxMaxNum;
+    }
+    for( x = ( uOSBase_t ) 0U; x < uxNum; x++ )
+    {
+        ptProfile[ x ] = atProfile[ x ];
+    }
+
+    return uxNum;
+}
+
+void OSIntProfileDump( OSIntProfileDumpFunction_t DumpFunction )
+{
+    tOSIntProfile_t atProfile[ OSINT_PROFILE_NUM ];
+    uOSBase_t uxNum = ( uOSBase_t ) 0U;
+    uOSBase_t x = ( uOSBase_t ) 0U;
+
+    uxNum = OSIntProfileGet( atProfile, ( uOSBase_t ) OSINT_PROFILE_NUM );
+    for( x = ( uOSBase_t ) 0U; x < uxNum; x++ )
+    {
+        DumpFunction( &( atProfile[ x ] ) );
+    }
+}
+
+void OSIntProfileReset( void )
+{
+    uOSBase_t x = ( uOSBase_t ) 0U;
+
+    FitIntLock();
+    {
+        for( x = ( uOSBase_t ) 0U; x < ( uOSBase_t ) OSINT_PROFILE_NUM; x++ )
+        {
+            gtOSIntProfile[ x ].pvCaller = OS_NULL;
+            gtOSIntProfile[ x ].uiMaxCycles = ( uOS32_t ) 0U;
+            gtOSIntProfile[ x ].uiCount = ( uOS32_t ) 0U;
+        }
+    }
+    FitIntUnlock();
+}
+#endif //( OS_INT_PROFILE_ON!=0 )
+
 #ifdef __cplusplus
 }
 #endif
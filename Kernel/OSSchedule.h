@@ -48,20 +48,47 @@ extern "C" {
 #define SCHEDULER_NOT_STARTED               ( ( sOSBase_t ) 1 )
 #define SCHEDULER_RUNNING                   ( ( sOSBase_t ) 2 )
 
+#if ( OS_INT_PROFILE_ON!=0 )
+#define OSIntLock()                         OSIntProfileLock()
+#define OSIntUnlock()                       OSIntProfileUnlock()
+
+#define OSIntMaskFromISR()                  OSIntProfileMaskFromISR()
+#define OSIntUnmaskFromISR( x )             OSIntProfileUnmaskFromISR( x )
+#else
 #define OSIntLock()                         FitIntLock()
 #define OSIntUnlock()                       FitIntUnlock()
 
 #define OSIntMaskFromISR()                  FitIntMaskFromISR()
 #define OSIntUnmaskFromISR( x )             FitIntUnmaskFromISR( x )
+#endif //( OS_INT_PROFILE_ON!=0 )
 
 #define OSIntMask()                         FitIntMask()
 #define OSIntUnmask( x )                    FitIntUnmask( x )
 
+/* The port pends the switch, PendSV on Cortex-M. A task calling it runs at
+base priority, so the pended switch is taken as soon as the call unmasks
+interrupts, before the task runs on; a yield or a blocking call switches
+where it is made, in the cooperative mode as well. */
 #define OSSchedule()                        FitSchedule()
 #define OSScheduleFromISR( b )              FitScheduleFromISR( b )
 
+#if ( OS_CYCLE_COUNTER_ON!=0 )
+#define OSGetCycleCount()                   FitGetCycleCount()
+#endif //( OS_CYCLE_COUNTER_ON!=0 )
+
 #define OSIsInsideISR()                     FitIsInsideISR()
 
+#if ( OS_INT_PROFILE_ON!=0 )
+typedef struct tOSIntProfile
+{
+    void *                  pvCaller;             /*< Address the masked section was entered from. */
+    uOS32_t                 uiMaxCycles;          /*< Longest masked duration of the call site in cycles. */
+    uOS32_t                 uiCount;              /*< Number of masked sections measured at the call site. */
+} tOSIntProfile_t;
+
+typedef void (*OSIntProfileDumpFunction_t)( const tOSIntProfile_t * const ptProfile );
+#endif //( OS_INT_PROFILE_ON!=0 )
+
 uOSBase_t    OSInit( void ) TINIUX_FUNCTION;
 uOSBase_t    OSStart( void ) TINIUX_FUNCTION;
 
@@ -72,8 +99,9 @@ uOSBool_t    OSScheduleIsLocked( void ) TINIUX_FUNCTION;
 
 sOSBase_t    OSScheduleGetState( void ) TINIUX_FUNCTION;
 void         OSNeedSchedule( void ) TINIUX_FUNCTION;
+void         OSNeedScheduleClear( void ) TINIUX_FUNCTION;
 
-uOSBool_t    OSIncrementTickCount( void ) TINIUX_FUNCTION;
+uOSBool_t    OSIncrementTickCount( void ) TINIUX_FAST_FUNCTION;
 uOSTick_t    OSGetTickCount( void ) TINIUX_FUNCTION;
 uOSTick_t    OSGetTickCountFromISR( void ) TINIUX_FUNCTION;
 
@@ -88,9 +116,25 @@ uOSTick_t    OSGetBlockTickCount( void ) TINIUX_FUNCTION;
 #endif //OS_LOWPOWER_ON
 void         OSUpdateUnblockTime( void ) TINIUX_FUNCTION;
 
-void         OSSetReadyPriority(uOSBase_t uxPriority) TINIUX_FUNCTION;
-void         OSResetReadyPriority(uOSBase_t uxPriority) TINIUX_FUNCTION;
-uOSBase_t    OSGetTopReadyPriority( void ) TINIUX_FUNCTION;
+void         OSSetReadyPriority(uOSBase_t uxPriority) TINIUX_FAST_FUNCTION;
+void         OSResetReadyPriority(uOSBase_t uxPriority) TINIUX_FAST_FUNCTION;
+uOSBase_t    OSGetTopReadyPriority( void ) TINIUX_FAST_FUNCTION;
+
+#if ( OS_BOOT_PROFILE_ON!=0 )
+/* Provided by the application, called with the cycles spent in each boot stage. */
+extern void  OSBootProfileHook( const char * pcStage, uOS32_t uiCycles );
+#endif //( OS_BOOT_PROFILE_ON!=0 )
+
+#if ( OS_INT_PROFILE_ON!=0 )
+void         OSIntProfileLock( void ) TINIUX_FUNCTION;
+void         OSIntProfileUnlock( void ) TINIUX_FUNCTION;
+uOSBase_t    OSIntProfileMaskFromISR( void ) TINIUX_FUNCTION;
+void         OSIntProfileUnmaskFromISR( uOSBase_t uxIntSave ) TINIUX_FUNCTION;
+
+uOSBase_t    OSIntProfileGet( tOSIntProfile_t * const ptProfile, uOSBase_t uxMaxNum ) TINIUX_FUNCTION;
+void         OSIntProfileDump( OSIntProfileDumpFunction_t DumpFunction ) TINIUX_FUNCTION;
+void         OSIntProfileReset( void ) TINIUX_FUNCTION;
+#endif //( OS_INT_PROFILE_ON!=0 )
 
 #ifdef __cplusplus
 }
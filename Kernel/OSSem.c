@@ -449,7 +449,7 @@ uOSBool_t OSSemPostFromISR( OSSemHandle_t SemHandle )
             {
                 if( OSListIsEmpty( &( ptSem->tTaskListEventSemP ) ) == OS_FALSE )
                 {
-                    if( OSTaskListEventRemove( &( ptSem->tTaskListEventSemP ) ) != OS_FALSE )
+                    if( OSTaskListEventRemoveFromISR( &( ptSem->tTaskListEventSemP ) ) != OS_FALSE )
                     {
                         bNeedSchedule = OS_TRUE;
                     }
@@ -42,17 +42,17 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 extern "C" {
 #endif
 
-TINIUX_DATA tOSTCB_t * volatile gptCurrentTCB                       = OS_NULL;
+TINIUX_FAST_DATA tOSTCB_t * volatile gptCurrentTCB                  = OS_NULL;
 TINIUX_DATA volatile  uOSBase_t guxCurrentTaskNum                   = ( uOSBase_t ) 0U;
 
 /* Lists for ready and blocked tasks. --------------------*/
-TINIUX_DATA static tOSList_t gtOSTaskListReady[ OSHIGHEAST_PRIORITY ];
-TINIUX_DATA static tOSList_t gtOSTaskListReadyPool;
+TINIUX_FAST_DATA static tOSList_t gtOSTaskListReady[ OSHIGHEAST_PRIORITY ];
+TINIUX_FAST_DATA static tOSList_t gtOSTaskListReadyPool;
 TINIUX_DATA static tOSList_t gptOSTaskListSuspended;
-TINIUX_DATA static tOSList_t gtOSTaskListPend1;
-TINIUX_DATA static tOSList_t gtOSTaskListPend2;
-TINIUX_DATA static tOSList_t * volatile gptOSTaskListPend           = OS_NULL;
-TINIUX_DATA static tOSList_t * volatile gptOSTaskListLongPeriodPend = OS_NULL;
+TINIUX_FAST_DATA static tOSList_t gtOSTaskListPend1;
+TINIUX_FAST_DATA static tOSList_t gtOSTaskListPend2;
+TINIUX_FAST_DATA static tOSList_t * volatile gptOSTaskListPend      = OS_NULL;
+TINIUX_FAST_DATA static tOSList_t * volatile gptOSTaskListLongPeriodPend = OS_NULL;
 
 // delete task
 #if ( OS_MEMFREE_ON != 0 )
@@ -60,12 +60,40 @@ TINIUX_DATA static tOSList_t gptOSTaskListRecycle;
 TINIUX_DATA static volatile  uOSBase_t guxTasksDeleted              = ( uOSBase_t ) 0U;
 #endif /* OS_MEMFREE_ON */
 
+TINIUX_DATA static uOS8_t const STACK_FILL_BYTE                     = ( ( uOS8_t ) 0xA1U );
+#if ( OS_STACK_WATERMARK_ON!=0 )
+TINIUX_DATA static uOSBase_t const STACK_CHECK_BYTES                = ( ( uOSBase_t ) 16U );
+#endif
+
 #if ( OS_TASK_SIGNAL_ON!=0 )
 TINIUX_DATA static uOS8_t const SIG_STATE_NOTWAITING                = ( ( uOS8_t ) 0 );
 TINIUX_DATA static uOS8_t const SIG_STATE_WAITING                   = ( ( uOS8_t ) 1 );
 TINIUX_DATA static uOS8_t const SIG_STATE_RECEIVED                  = ( ( uOS8_t ) 2 );
 #endif
 
+#if ( OS_TASK_IPC_ON!=0 )
+TINIUX_DATA static uOS8_t const IPC_STATE_NONE                      = ( ( uOS8_t ) 0 );
+TINIUX_DATA static uOS8_t const IPC_STATE_RECEIVING                 = ( ( uOS8_t ) 1 );
+TINIUX_DATA static uOS8_t const IPC_STATE_SERVING                   = ( ( uOS8_t ) 2 );
+TINIUX_DATA static uOS8_t const IPC_STATE_CALLING                   = ( ( uOS8_t ) 3 );
+TINIUX_DATA static uOS8_t const IPC_STATE_REPLYWAIT                 = ( ( uOS8_t ) 4 );
+TINIUX_DATA static uOS8_t const IPC_STATE_REPLIED                   = ( ( uOS8_t ) 5 );
+
+/* The partner of a call or reply, switched to directly by the next switch. */
+TINIUX_FAST_DATA static tOSTCB_t * volatile gptIPCHandoffTCB        = OS_NULL;
+#endif
+
+#if ( OS_LATENCY_TRACE_ON!=0 )
+TINIUX_DATA static tOSLatencyStats_t gtOSLatencyStats;
+#endif
+
+#if ( OS_COOPERATIVE_ON!=0 )
+TINIUX_DATA static tOSTCB_t * volatile gptIdleTCB                   = OS_NULL;
+#endif
+#if ( OS_COOPERATIVE_ON!=0 ) || ( OS_PREEMPT_THRESHOLD_ON!=0 )
+TINIUX_DATA static volatile  uOSBool_t gbYieldPending               = OS_FALSE;
+#endif
+
 static void OSTaskListInit( void )
 {
     uOSBase_t uxPriority = ( uOSBase_t ) 0U;
@@ -100,6 +128,10 @@ uOSBase_t OSTaskInit( void )
 
     OSTaskListInit();
 
+#if ( OS_LATENCY_TRACE_ON!=0 )
+    OSTaskLatencyReset();
+#endif
+
     return 0U;
 }
 
@@ -108,7 +140,8 @@ static void* OSTaskGetTCBFromHandle(OSTaskHandle_t const pxHandle)
     return ( ( ( pxHandle ) == OS_NULL ) ? ( tOSTCB_t * ) gptCurrentTCB : ( tOSTCB_t * ) ( pxHandle ) );
 }
 
-static void OSTaskSelectToSchedule()
+static void OSTaskSelectToSchedule( void ) TINIUX_FAST_FUNCTION;
+static void OSTaskSelectToSchedule( void )
 {
     uOSBase_t uxTopPriority = ( uOSBase_t ) 0U;
 
@@ -145,7 +178,7 @@ static OSTaskHandle_t OSAllocateTCBAndStack( const uOS16_t usStackDepth, uOSStac
         }
         else
         {
-            memset( (void*)ptNewTCB->puxStartStack, ( uOS8_t ) 0xA1U, ( uOS32_t ) usStackDepth * sizeof( uOSStack_t ) );
+            memset( (void*)ptNewTCB->puxStartStack, STACK_FILL_BYTE, ( uOS32_t ) usStackDepth * sizeof( uOSStack_t ) );
         }
     }
 
@@ -174,17 +207,71 @@ static void OSTaskInitTCB( tOSTCB_t * const ptTCB, const char * const pcName, uO
 
     ptTCB->uxPriority = uxPriority;
 
+    #if ( OS_STACK_WATERMARK_ON!=0 )
+    {
+        ptTCB->usStackDepth = usStackDepth;
+    }
+    #endif //( OS_STACK_WATERMARK_ON!=0 )
+
+    #if ( OSTIME_SLICE_ON!=0 )
+    {
+        ptTCB->uxTimeSliceTicks = ( uOSTick_t ) OSTIME_SLICE_TICKS;
+        ptTCB->uxTimeSliceLeft = ( uOSTick_t ) OSTIME_SLICE_TICKS;
+    }
+    #endif //( OSTIME_SLICE_ON!=0 )
+
+    #if ( OS_PREEMPT_THRESHOLD_ON!=0 )
+    {
+        ptTCB->uxPreemptThreshold = uxPriority;
+    }
+    #endif //( OS_PREEMPT_THRESHOLD_ON!=0 )
+
+    #if ( OS_TASK_BUDGET_ON!=0 )
+    {
+        ptTCB->uxBudgetTicks = ( uOSTick_t ) 0U;
+        ptTCB->uxBudgetPeriod = ( uOSTick_t ) 0U;
+        ptTCB->uxBudgetPeriodStart = ( uOSTick_t ) 0U;
+        ptTCB->uxBudgetLeft = ( uOSTick_t ) 0U;
+    }
+    #endif //( OS_TASK_BUDGET_ON!=0 )
+
     #if ( OS_MUTEX_ON!= 0 )
     {
         ptTCB->uxBasePriority = uxPriority;
         ptTCB->uxMutexHoldNum = 0;
+        ptTCB->ptMutexHoldList = OS_NULL;
+        ptTCB->ptMutexPended = OS_NULL;
+        #if ( OS_RWLOCK_ON!=0 )
+        ptTCB->ptRWLockHoldList = OS_NULL;
+        #endif
     }
     #endif // ( OS_MUTEX_ON!= 0 )
     
+    #if ( OS_LATENCY_TRACE_ON!=0 )
+    {
+        ptTCB->uiWakeCycle = 0UL;
+    }
+    #endif // ( OS_LATENCY_TRACE_ON!=0 )
+
+    #if ( OS_TASK_IPC_ON!=0 )
+    {
+        OSListInit( &( ptTCB->tIPCCallList ) );
+        ptTCB->ptIPCPartner = OS_NULL;
+        ptTCB->uiIPCMsg = 0UL;
+        ptTCB->ucIPCState = IPC_STATE_NONE;
+        #if ( OS_MUTEX_ON==0 )
+        ptTCB->uxIPCBasePriority = uxPriority;
+        #endif
+    }
+    #endif // ( OS_TASK_IPC_ON!=0 )
+
     #if ( OS_TASK_SIGNAL_ON!=0 )
     {
-        ptTCB->ucSigState = SIG_STATE_NOTWAITING;        /*< Task signal state: NotWaiting Waiting Received. */
-        ptTCB->uiSigValue = 0;                            /*< Task signal value: Msg or count. */        
+        for( x = ( uOSBase_t ) 0; x < ( uOSBase_t ) OSTASK_SIGNAL_SLOTS; x++ )
+        {
+            ptTCB->ucSigState[ x ] = SIG_STATE_NOTWAITING;    /*< Task signal state: NotWaiting Waiting Received. */
+            ptTCB->uiSigValue[ x ] = 0;                        /*< Task signal value: Msg or count. */
+        }
     }
     #endif // OS_TASK_SIGNAL_ON!=0
         
@@ -262,7 +349,7 @@ OSTaskHandle_t OSTaskCreate(OSTaskFunction_t    pxTaskFunction,
     {
         if( OSScheduleGetState() != SCHEDULER_NOT_STARTED )
         {
-            if( gptCurrentTCB->uxPriority < uxPriority )
+            if( OSTaskGetPreemptPriority() < uxPriority )
             {
                 OSSchedule();
             }
@@ -365,10 +452,9 @@ static void OSTaskListRecycleRemove( void )
 }
 #endif /* OS_MEMFREE_ON */
 
-static void OSTaskListPendAdd(tOSTCB_t* ptTCB, const uOSTick_t uxTicksToWait, uOSBool_t bNeedSuspend )
+static void OSTaskListPendInsert(tOSTCB_t* ptTCB, const uOSTick_t uxTickCount, const uOSTick_t uxTicksToWait, uOSBool_t bNeedSuspend )
 {
     uOSTick_t uxTimeToWake = (uOSTick_t)0U;
-    const uOSTick_t uxTickCount = OSGetTickCount();
     
     if(ptTCB == OS_NULL)
     {
@@ -401,6 +487,11 @@ static void OSTaskListPendAdd(tOSTCB_t* ptTCB, const uOSTick_t uxTicksToWait, uO
     }    
 }
 
+static void OSTaskListPendAdd(tOSTCB_t* ptTCB, const uOSTick_t uxTicksToWait, uOSBool_t bNeedSuspend )
+{
+    OSTaskListPendInsert( ptTCB, OSGetTickCount(), uxTicksToWait, bNeedSuspend );
+}
+
 void OSTaskListPendSwitch( void )
 {
     tOSList_t *ptTempList = OS_NULL;
@@ -436,7 +527,7 @@ uOSBool_t OSTaskListEventRemove( const tOSList_t * const ptEventList )
         OSListInsertItemToEnd( &( gtOSTaskListReadyPool ), &( pxUnblockedTCB->tEventListItem ) );
     }
 
-    if( pxUnblockedTCB->uxPriority > gptCurrentTCB->uxPriority )
+    if( pxUnblockedTCB->uxPriority > OSTaskGetPreemptPriority() )
     {
         bReturn = OS_TRUE;
         OSNeedSchedule();
@@ -450,6 +541,124 @@ uOSBool_t OSTaskListEventRemove( const tOSList_t * const ptEventList )
     return bReturn;
 }
 
+#if ( OS_LATENCY_TRACE_ON!=0 )
+static void OSTaskLatencyMark( tOSTCB_t * const ptTCB )
+{
+    /* Keep the first wake if the task is woken again before it runs, 0
+    is reserved for no wake pending. */
+    if( ptTCB->uiWakeCycle == 0UL )
+    {
+        ptTCB->uiWakeCycle = OSGetCycleCount() | 1UL;
+    }
+}
+
+static void OSTaskLatencyRecord( tOSTCB_t * const ptTCB )
+{
+    uOS32_t uiLatency = 0UL;
+    uOS32_t uiBucket = 0UL;
+
+    uiLatency = OSGetCycleCount() - ptTCB->uiWakeCycle;
+    ptTCB->uiWakeCycle = 0UL;
+
+    if( ( gtOSLatencyStats.uiCount == 0UL ) || ( uiLatency < gtOSLatencyStats.uiMin ) )
+    {
+        gtOSLatencyStats.uiMin = uiLatency;
+    }
+    if( uiLatency > gtOSLatencyStats.uiMax )
+    {
+        gtOSLatencyStats.uiMax = uiLatency;
+    }
+    gtOSLatencyStats.uiSum += uiLatency;
+    gtOSLatencyStats.uiCount++;
+
+    uiBucket = uiLatency >> OSLATENCY_HIST_SHIFT;
+    if( uiBucket >= ( uOS32_t ) OSLATENCY_HIST_NUM )
+    {
+        uiBucket = ( uOS32_t ) OSLATENCY_HIST_NUM - 1UL;
+    }
+    gtOSLatencyStats.uiHist[ uiBucket ]++;
+}
+
+void OSTaskLatencyGetStats( tOSLatencyStats_t * const ptStats )
+{
+    OSIntLock();
+    {
+        *ptStats = gtOSLatencyStats;
+    }
+    OSIntUnlock();
+}
+
+uOS32_t OSTaskLatencyGetPercentile( uOSBase_t uxPercent )
+{
+    uOS32_t uiTarget = 0UL;
+    uOS32_t uiSeen = 0UL;
+    uOS32_t uiMax = 0UL;
+    uOSBase_t x = ( uOSBase_t ) 0U;
+
+    if( uxPercent > ( uOSBase_t ) 100U )
+    {
+        uxPercent = ( uOSBase_t ) 100U;
+    }
+
+    OSIntLock();
+    {
+        uiMax = gtOSLatencyStats.uiMax;
+
+        /* Round up, so the percentile is never below the requested share.
+        The hundreds and the rest of the count are scaled apart, the count
+        times the percent would overflow 32 bits. */
+        uiTarget = ( gtOSLatencyStats.uiCount / 100UL ) * ( uOS32_t ) uxPercent;
+        uiTarget += ( ( ( gtOSLatencyStats.uiCount % 100UL ) * ( uOS32_t ) uxPercent ) + 99UL ) / 100UL;
+
+        for( x = ( uOSBase_t ) 0U; x < ( uOSBase_t ) ( OSLATENCY_HIST_NUM - 1U ); x++ )
+        {
+            uiSeen += gtOSLatencyStats.uiHist[ x ];
+            if( uiSeen >= uiTarget )
+            {
+                break;
+            }
+        }
+    }
+    OSIntUnlock();
+
+    /* The upper bound of the bucket, the last bucket is bounded by the max. */
+    if( x >= ( uOSBase_t ) ( OSLATENCY_HIST_NUM - 1U ) )
+    {
+        return uiMax;
+    }
+    return ( ( ( uOS32_t ) x + 1UL ) << OSLATENCY_HIST_SHIFT ) - 1UL;
+}
+
+void OSTaskLatencyReset( void )
+{
+    uOSBase_t x = ( uOSBase_t ) 0U;
+
+    OSIntLock();
+    {
+        gtOSLatencyStats.uiCount = 0UL;
+        gtOSLatencyStats.uiMin = 0UL;
+        gtOSLatencyStats.uiMax = 0UL;
+        gtOSLatencyStats.uiSum = 0UL;
+        for( x = ( uOSBase_t ) 0U; x < ( uOSBase_t ) OSLATENCY_HIST_NUM; x++ )
+        {
+            gtOSLatencyStats.uiHist[ x ] = 0UL;
+        }
+    }
+    OSIntUnlock();
+}
+#endif //( OS_LATENCY_TRACE_ON!=0 )
+
+uOSBool_t OSTaskListEventRemoveFromISR( const tOSList_t * const ptEventList )
+{
+    #if ( OS_LATENCY_TRACE_ON!=0 )
+    {
+        OSTaskLatencyMark( ( tOSTCB_t * ) OSListGetHeadItemHolder( ptEventList ) );
+    }
+    #endif //( OS_LATENCY_TRACE_ON!=0 )
+
+    return OSTaskListEventRemove( ptEventList );
+}
+
 uOSBase_t OSTaskListPendNum( void )
 {
     return OSListGetLength( gptOSTaskListPend );
@@ -475,36 +684,318 @@ uOSBase_t OSTaskListReadyNum( uOSBase_t uxPriority )
     return OSListGetLength( &( gtOSTaskListReady[ ( uxPriority ) ] ) );
 }
 
+#if ( OS_STACK_WATERMARK_ON!=0 )
+static uOSBase_t OSTaskStackFreeBytes( const tOSTCB_t * const ptTCB, uOSBase_t uxMaxBytes )
+{
+    uOSBase_t uxCount = ( uOSBase_t ) 0U;
+    uOSBase_t uxStackBytes = ( uOSBase_t ) ptTCB->usStackDepth * ( uOSBase_t ) sizeof( uOSStack_t );
+
+    /* Count the bytes at the far end of the stack which still hold the fill
+    pattern written when the task was created, never past the stack itself. */
+    #if( OSSTACK_GROWTH < 0 )
+    {
+        #if ( OS_MPU_STACK_GUARD_ON!=0 )
+        /* The guard region cannot be read, start right above it. */
+        const uOS8_t * pucStackByte = ( const uOS8_t * ) FitMPUStackGuardEnd( ptTCB->puxStartStack );
+        uxStackBytes -= ( uOSBase_t ) ( pucStackByte - ( const uOS8_t * ) ptTCB->puxStartStack );
+        #else
+        const uOS8_t * pucStackByte = ( const uOS8_t * ) ptTCB->puxStartStack;
+        #endif //( OS_MPU_STACK_GUARD_ON!=0 )
+
+        if( uxMaxBytes > uxStackBytes )
+        {
+            uxMaxBytes = uxStackBytes;
+        }
+
+        while( ( uxCount < uxMaxBytes ) && ( *pucStackByte == STACK_FILL_BYTE ) )
+        {
+            pucStackByte++;
+            uxCount++;
+        }
+    }
+    #else
+    {
+        const uOS8_t * pucStackByte = ( ( const uOS8_t * ) ( ( uOSStack_t * ) ptTCB->puxEndOfStack + 1 ) ) - 1;
+
+        if( uxMaxBytes > uxStackBytes )
+        {
+            uxMaxBytes = uxStackBytes;
+        }
+
+        while( ( uxCount < uxMaxBytes ) && ( *pucStackByte == STACK_FILL_BYTE ) )
+        {
+            pucStackByte--;
+            uxCount++;
+        }
+    }
+    #endif
+
+    return uxCount;
+}
+#endif //( OS_STACK_WATERMARK_ON!=0 )
+
 static void OSTaskCheckStackStatus()
 {
     uOSStack_t* puxStackTemp = (uOSStack_t*)gptCurrentTCB->puxTopOfStack;
+    uOSBool_t bOverflow = OS_FALSE;
 
     #if( OSSTACK_GROWTH < 0 )
     if( puxStackTemp <= gptCurrentTCB->puxStartStack )
     {// Task stack overflow
-        for( ; ; );
+        bOverflow = OS_TRUE;
     }
     #else
-    if( puxStackTemp >= gptCurrentTCB->puxEndOfStack )
+    if( puxStackTemp >= ( uOSStack_t* )gptCurrentTCB->puxEndOfStack )
     {// Task stack overflow
-        for( ; ; );
+        bOverflow = OS_TRUE;
     }
     #endif
+
+    #if ( OS_STACK_WATERMARK_ON!=0 )
+    {
+        /* The stack pointer may be back in range while the stack has been
+        overflowed earlier, the fill pattern at the far end tells. */
+        if( OSTaskStackFreeBytes( gptCurrentTCB, STACK_CHECK_BYTES ) < STACK_CHECK_BYTES )
+        {
+            bOverflow = OS_TRUE;
+        }
+    }
+    #endif //( OS_STACK_WATERMARK_ON!=0 )
+
+    if( bOverflow != OS_FALSE )
+    {
+        #if ( OS_STACK_OVERFLOW_HOOK_ON!=0 )
+        OSStackOverflowHook( gptCurrentTCB, gptCurrentTCB->pcTaskName );
+        #else
+        for( ; ; );
+        #endif //( OS_STACK_OVERFLOW_HOOK_ON!=0 )
+    }
+}
+
+#if ( OS_TASK_IPC_ON!=0 )
+/* Switch straight to the partner of a call or reply instead of taking the
+next task in the ready list, unless an ISR made a higher priority task ready
+meanwhile. */
+static uOSBool_t OSTaskIPCHandoff( void )
+{
+    tOSTCB_t * const ptTCB = gptIPCHandoffTCB;
+    uOSBool_t bReturn = OS_FALSE;
+
+    gptIPCHandoffTCB = OS_NULL;
+
+    if( ptTCB != OS_NULL )
+    {
+        if( ( OSListContainListItem( &( gtOSTaskListReady[ ptTCB->uxPriority ] ), &( ptTCB->tTaskListItem ) ) != OS_FALSE ) &&
+            ( ptTCB->uxPriority >= OSGetTopReadyPriority() ) )
+        {
+            gptCurrentTCB = ptTCB;
+            bReturn = OS_TRUE;
+
+            #if ( OS_COOPERATIVE_ON!=0 ) || ( OS_PREEMPT_THRESHOLD_ON!=0 )
+            /* The yield is served by the handoff as well. */
+            gbYieldPending = OS_FALSE;
+            #endif
+        }
+    }
+
+    return bReturn;
+}
+#endif //( OS_TASK_IPC_ON!=0 )
+
+#if ( OS_COOPERATIVE_ON!=0 ) || ( OS_PREEMPT_THRESHOLD_ON!=0 )
+/* Whether the running task keeps the CPU on this switch, it always gives
+way once it blocked or yielded. */
+static uOSBool_t OSTaskKeepRunning( void )
+{
+    uOSBool_t bKeep = OS_FALSE;
+
+    if( ( gbYieldPending == OS_FALSE ) &&
+        ( OSListContainListItem( &( gtOSTaskListReady[ gptCurrentTCB->uxPriority ] ), &( gptCurrentTCB->tTaskListItem ) ) != OS_FALSE ) )
+    {
+        #if ( OS_COOPERATIVE_ON!=0 )
+        {
+            /* Only the idle task gives way to a task made ready. */
+            if( gptCurrentTCB != gptIdleTCB )
+            {
+                bKeep = OS_TRUE;
+            }
+        }
+        #endif //( OS_COOPERATIVE_ON!=0 )
+
+        #if ( OS_PREEMPT_THRESHOLD_ON!=0 )
+        {
+            /* No task above the threshold is ready, equal priorities do not
+            take turns either. */
+            if( ( gptCurrentTCB->uxPreemptThreshold > gptCurrentTCB->uxPriority ) &&
+                ( OSGetTopReadyPriority() <= gptCurrentTCB->uxPreemptThreshold ) )
+            {
+                bKeep = OS_TRUE;
+            }
+        }
+        #endif //( OS_PREEMPT_THRESHOLD_ON!=0 )
+    }
+    gbYieldPending = OS_FALSE;
+
+    return bKeep;
 }
+#endif
 
 void OSTaskSwitchContext( void )
 {
     if( OSScheduleIsLocked() != OS_FALSE )
     {
         OSNeedSchedule();
+
+        #if ( OS_TASK_IPC_ON!=0 )
+        /* The deferred switch takes the next task from the ready list, the
+        partner may no longer be ready when the scheduler is unlocked. */
+        gptIPCHandoffTCB = OS_NULL;
+        #endif //( OS_TASK_IPC_ON!=0 )
     }
     else
     {
-        OSNeedSchedule();
+        #if ( OSTIME_SLICE_ON!=0 )
+        tOSTCB_t * const ptPrevTCB = gptCurrentTCB;
+        #endif //( OSTIME_SLICE_ON!=0 )
+
+        OSNeedScheduleClear();
 
         OSTaskCheckStackStatus();
+
+        #if ( OS_TASK_IPC_ON!=0 )
+        if( OSTaskIPCHandoff() == OS_FALSE )
+        #endif //( OS_TASK_IPC_ON!=0 )
+        #if ( OS_COOPERATIVE_ON!=0 ) || ( OS_PREEMPT_THRESHOLD_ON!=0 )
+        if( OSTaskKeepRunning() == OS_FALSE )
+        {
+            OSTaskSelectToSchedule();
+        }
+        #else
         OSTaskSelectToSchedule();
+        #endif
+
+        #if ( OSTIME_SLICE_ON!=0 )
+        /* A task switched in starts a full turn. */
+        if( gptCurrentTCB != ptPrevTCB )
+        {
+            gptCurrentTCB->uxTimeSliceLeft = gptCurrentTCB->uxTimeSliceTicks;
+        }
+        #endif //( OSTIME_SLICE_ON!=0 )
+
+        #if ( OS_LATENCY_TRACE_ON!=0 )
+        if( gptCurrentTCB->uiWakeCycle != 0UL )
+        {
+            OSTaskLatencyRecord( gptCurrentTCB );
+        }
+        #endif //( OS_LATENCY_TRACE_ON!=0 )
+
+        #if ( OS_MPU_STACK_GUARD_ON!=0 )
+        /* Move the MPU guard region to the bottom of the incoming task's stack. */
+        FitMPUStackGuard( gptCurrentTCB->puxStartStack );
+        #endif //( OS_MPU_STACK_GUARD_ON!=0 )
+    }
+}
+
+#if ( OS_COOPERATIVE_ON!=0 ) || ( OS_PREEMPT_THRESHOLD_ON!=0 )
+/* The priority a task made ready has to be above to preempt the running
+task, a macro reading the running task's priority in the other builds. */
+uOSBase_t OSTaskGetPreemptPriority( void )
+{
+    #if ( OS_COOPERATIVE_ON!=0 )
+    {
+        if( gptCurrentTCB != gptIdleTCB )
+        {
+            return ( uOSBase_t ) OSHIGHEAST_PRIORITY;
+        }
+    }
+    #endif //( OS_COOPERATIVE_ON!=0 )
+
+    #if ( OS_PREEMPT_THRESHOLD_ON!=0 )
+    {
+        if( gptCurrentTCB->uxPreemptThreshold > gptCurrentTCB->uxPriority )
+        {
+            return gptCurrentTCB->uxPreemptThreshold;
+        }
+    }
+    #endif //( OS_PREEMPT_THRESHOLD_ON!=0 )
+
+    return gptCurrentTCB->uxPriority;
+}
+
+/* The lowest priority a task made ready needs to take the CPU at the next
+switch: the running task's own priority, which gives equal priorities
+their turn, or one above a threshold raised over it. */
+uOSBase_t OSTaskGetMinPreemptPriority( void )
+{
+    uOSBase_t uxPreemptPriority = OSTaskGetPreemptPriority();
+
+    if( uxPreemptPriority > gptCurrentTCB->uxPriority )
+    {
+        uxPreemptPriority++;
+    }
+
+    return uxPreemptPriority;
+}
+#endif //( OS_COOPERATIVE_ON!=0 ) || ( OS_PREEMPT_THRESHOLD_ON!=0 )
+
+#if ( OS_PREEMPT_THRESHOLD_ON!=0 )
+/* Set the priority only tasks above preempt the task, it takes effect while
+above the priority of the task, returns the former threshold. */
+uOSBase_t OSTaskSetPreemptThreshold( OSTaskHandle_t const TaskHandle, uOSBase_t uxThreshold )
+{
+    tOSTCB_t *ptTCB = OS_NULL;
+    uOSBase_t uxOldThreshold = ( uOSBase_t ) 0U;
+
+    if( uxThreshold >= ( uOSBase_t ) OSHIGHEAST_PRIORITY )
+    {
+        uxThreshold = ( uOSBase_t ) OSHIGHEAST_PRIORITY - ( uOSBase_t ) 1U;
+    }
+
+    OSIntLock();
+    {
+        ptTCB = OSTaskGetTCBFromHandle( TaskHandle );
+        uxOldThreshold = ptTCB->uxPreemptThreshold;
+        ptTCB->uxPreemptThreshold = uxThreshold;
+
+        /* A ready task held back by the former threshold may run now. */
+        if( ( ptTCB == gptCurrentTCB ) && ( uxThreshold < uxOldThreshold ) )
+        {
+            if( OSScheduleGetState() != SCHEDULER_NOT_STARTED )
+            {
+                OSSchedule();
+            }
+        }
+    }
+    OSIntUnlock();
+
+    return uxOldThreshold;
+}
+
+uOSBase_t OSTaskGetPreemptThreshold( OSTaskHandle_t const TaskHandle )
+{
+    tOSTCB_t *ptTCB = OS_NULL;
+    uOSBase_t uxReturn = ( uOSBase_t ) 0U;
+
+    OSIntLock();
+    {
+        ptTCB = OSTaskGetTCBFromHandle( TaskHandle );
+        uxReturn = ptTCB->uxPreemptThreshold;
+    }
+    OSIntUnlock();
+
+    return uxReturn;
+}
+#endif //( OS_PREEMPT_THRESHOLD_ON!=0 )
+
+void OSTaskYield( void )
+{
+    #if ( OS_COOPERATIVE_ON!=0 ) || ( OS_PREEMPT_THRESHOLD_ON!=0 )
+    {
+        gbYieldPending = OS_TRUE;
     }
+    #endif
+
+    OSSchedule();
 }
 
 void OSTaskSleep( const uOSTick_t uxTicksToSleep )
@@ -522,7 +1013,7 @@ void OSTaskSleep( const uOSTick_t uxTicksToSleep )
 
     if( bAlreadyScheduled == OS_FALSE )
     {
-        OSSchedule();
+        OSTaskYield();
     }
 }
 
@@ -664,7 +1155,7 @@ void OSTaskSetPriority( OSTaskHandle_t TaskHandle, uOSBase_t uxNewPriority )
             {
                 if( ptTCB != gptCurrentTCB )
                 {
-                    if( uxNewPriority >= gptCurrentTCB->uxPriority )
+                    if( uxNewPriority >= OSTaskGetMinPreemptPriority() )
                     {
                         bNeedSchedule = OS_TRUE;
                     }
@@ -713,162 +1204,756 @@ void OSTaskSetPriority( OSTaskHandle_t TaskHandle, uOSBase_t uxNewPriority )
     OSIntUnlock();
 }
 
-#if ( OS_MUTEX_ON!= 0 )
-void *OSTaskGetMutexHolder( void )
+#if ( OS_MUTEX_ON!= 0 ) || ( OS_TASK_IPC_ON!=0 )
+static void OSTaskPriorityMove( tOSTCB_t * const ptTCB, uOSBase_t uxNewPriority )
 {
-    if( gptCurrentTCB != OS_NULL )
+    const uOSBase_t uxPriorityUsedOnEntry = ptTCB->uxPriority;
+    tOSList_t * const ptEventList = ( tOSList_t * ) OSListItemGetList( &( ptTCB->tEventListItem ) );
+
+    OSListItemSetValue( &( ptTCB->tEventListItem ), ( uOSTick_t ) OSHIGHEAST_PRIORITY - ( uOSTick_t ) uxNewPriority );
+
+    /* A blocked task must keep its place in the priority ordered event list,
+    otherwise the head of a mutex event list is no longer the highest priority
+    waiting task. */
+    if( ( ptEventList != OS_NULL ) && ( ptEventList != &gtOSTaskListReadyPool ) )
     {
-        ( gptCurrentTCB->uxMutexHoldNum )++;
+        ( void ) OSListRemoveItem( &( ptTCB->tEventListItem ) );
+        OSListInsertItem( ptEventList, &( ptTCB->tEventListItem ) );
     }
-    return gptCurrentTCB;
-}
 
-uOSBool_t OSTaskPriorityInherit( OSTaskHandle_t const MutexHolderTaskHandle )
-{
-    tOSTCB_t * const ptMutexHolderTCB = ( tOSTCB_t * ) MutexHolderTaskHandle;
-    uOSBool_t bReturn = OS_FALSE;
-    
-    if( MutexHolderTaskHandle != OS_NULL )
+    /* Only a task in the Ready state has to move, there is one Ready list per
+    priority. */
+    if( OSListContainListItem( &( gtOSTaskListReady[ uxPriorityUsedOnEntry ] ), &( ptTCB->tTaskListItem ) ) != OS_FALSE )
     {
-        if( ptMutexHolderTCB->uxPriority < gptCurrentTCB->uxPriority )
+        if( OSListRemoveItem( &( ptTCB->tTaskListItem ) ) == ( uOSBase_t ) 0U )
         {
-            OSListItemSetValue( &( ptMutexHolderTCB->tEventListItem ), ( uOSTick_t ) OSHIGHEAST_PRIORITY - ( uOSTick_t ) gptCurrentTCB->uxPriority );
+            OSResetReadyPriority( uxPriorityUsedOnEntry );
+        }
+
+        ptTCB->uxPriority = uxNewPriority;
+        OSTaskListReadyAdd( ptTCB );
+    }
+    else
+    {
+        ptTCB->uxPriority = uxNewPriority;
+    }
+}
+
+#endif /* ( OS_MUTEX_ON!= 0 ) || ( OS_TASK_IPC_ON!=0 ) */
+
+#if ( OS_MUTEX_ON!= 0 )
+static tOSTCB_t * OSTaskGetMutexPendedHolder( const tOSTCB_t * const ptTCB )
+{
+    const tOSMutex_t * const ptMutex = ptTCB->ptMutexPended;
+    tOSTCB_t * ptHolderTCB = OS_NULL;
 
-            if( OSListContainListItem( &( gtOSTaskListReady[ ptMutexHolderTCB->uxPriority ] ), &( ptMutexHolderTCB->tTaskListItem ) ) != OS_FALSE )
+    /* Only follow the chain while the task is still waiting for the mutex. */
+    if( ptMutex != OS_NULL )
+    {
+        if( OSListContainListItem( &( ptMutex->tTaskListEventMutexP ), &( ptTCB->tEventListItem ) ) != OS_FALSE )
+        {
+            ptHolderTCB = ( tOSTCB_t * ) ptMutex->MutexHolderHandle;
+        }
+    }
+
+    return ptHolderTCB;
+}
+
+static uOSBase_t OSTaskGetInheritedPriority( const tOSTCB_t * const ptTCB )
+{
+    uOSBase_t uxPriority = ptTCB->uxBasePriority;
+    uOSBase_t uxWaitingPriority = (uOSBase_t)0U;
+    const tOSMutex_t * ptMutex = ptTCB->ptMutexHoldList;
+
+    /* The task runs at the highest of its base priority and the priorities
+    of all tasks waiting for any mutex it still holds. */
+    while( ptMutex != OS_NULL )
+    {
+        if( OSListIsEmpty( &( ptMutex->tTaskListEventMutexP ) ) == OS_FALSE )
+        {
+            uxWaitingPriority = ( uOSBase_t ) ( OSHIGHEAST_PRIORITY - OSlistGetHeadItemValue( &( ptMutex->tTaskListEventMutexP ) ) );
+            if( uxWaitingPriority > uxPriority )
+            {
+                uxPriority = uxWaitingPriority;
+            }
+        }
+
+        #if ( OS_MUTEX_CEILING_ON!=0 )
+        {
+            if( ( ptMutex->uxCeilingPriority < ( uOSBase_t ) OSHIGHEAST_PRIORITY ) && ( ptMutex->uxCeilingPriority > uxPriority ) )
+            {
+                uxPriority = ptMutex->uxCeilingPriority;
+            }
+        }
+        #endif /* ( OS_MUTEX_CEILING_ON!=0 ) */
+
+        ptMutex = ptMutex->ptNextHoldMutex;
+    }
+
+    #if ( OS_RWLOCK_ON!=0 )
+    {
+        const tOSRWLock_t * ptRWLock = ptTCB->ptRWLockHoldList;
+
+        /* Tasks waiting for a RW lock held for writing are waiting for the
+        writer too. */
+        while( ptRWLock != OS_NULL )
+        {
+            if( OSListIsEmpty( &( ptRWLock->tTaskListEventRead ) ) == OS_FALSE )
             {
-                if( OSListRemoveItem( &( ptMutexHolderTCB->tTaskListItem ) ) == ( uOSBase_t ) 0U )
+                uxWaitingPriority = ( uOSBase_t ) ( OSHIGHEAST_PRIORITY - OSlistGetHeadItemValue( &( ptRWLock->tTaskListEventRead ) ) );
+                if( uxWaitingPriority > uxPriority )
                 {
-                    OSResetReadyPriority( ptMutexHolderTCB->uxPriority );
+                    uxPriority = uxWaitingPriority;
                 }
+            }
+            if( OSListIsEmpty( &( ptRWLock->tTaskListEventWrite ) ) == OS_FALSE )
+            {
+                uxWaitingPriority = ( uOSBase_t ) ( OSHIGHEAST_PRIORITY - OSlistGetHeadItemValue( &( ptRWLock->tTaskListEventWrite ) ) );
+                if( uxWaitingPriority > uxPriority )
+                {
+                    uxPriority = uxWaitingPriority;
+                }
+            }
 
-                ptMutexHolderTCB->uxPriority = gptCurrentTCB->uxPriority;
-                OSTaskListReadyAdd( ptMutexHolderTCB );
+            ptRWLock = ptRWLock->ptNextHoldRWLock;
+        }
+    }
+    #endif /* ( OS_RWLOCK_ON!=0 ) */
+
+    #if ( OS_TASK_IPC_ON!=0 )
+    {
+        /* A server runs at the priority of the client it serves. */
+        if( ( ptTCB->ucIPCState == IPC_STATE_SERVING ) && ( ptTCB->ptIPCPartner != OS_NULL ) )
+        {
+            if( ptTCB->ptIPCPartner->uxPriority > uxPriority )
+            {
+                uxPriority = ptTCB->ptIPCPartner->uxPriority;
             }
-            else
+        }
+
+        /* And at the priority of the highest caller still queued. */
+        if( OSListIsEmpty( &( ptTCB->tIPCCallList ) ) == OS_FALSE )
+        {
+            uxWaitingPriority = ( uOSBase_t ) ( OSHIGHEAST_PRIORITY - OSlistGetHeadItemValue( &( ptTCB->tIPCCallList ) ) );
+            if( uxWaitingPriority > uxPriority )
             {
-                /* Just inherit the priority. */
-                ptMutexHolderTCB->uxPriority = gptCurrentTCB->uxPriority;
+                uxPriority = uxWaitingPriority;
             }
-            
-            /* Inheritance occurred. */
+        }
+    }
+    #endif /* ( OS_TASK_IPC_ON!=0 ) */
+
+    return uxPriority;
+}
+
+static void OSTaskPriorityPropagate( tOSTCB_t * ptTCB, uOSBase_t uxPriority )
+{
+    uOSBase_t uxDepth = ( uOSBase_t ) 0U;
+
+    /* Pass the priority down the chain while the holder is itself
+    blocked on another mutex. */
+    while( ( ptTCB != OS_NULL ) && ( uxDepth < ( uOSBase_t ) OSMUTEX_INHERIT_DEPTH ) )
+    {
+        if( ptTCB->uxPriority >= uxPriority )
+        {
+            break;
+        }
+
+        OSTaskPriorityMove( ptTCB, uxPriority );
+
+        ptTCB = OSTaskGetMutexPendedHolder( ptTCB );
+        uxDepth++;
+    }
+}
+
+void *OSTaskGetMutexHolder( void * const pvMutex )
+{
+    tOSMutex_t * const ptMutex = ( tOSMutex_t * ) pvMutex;
+
+    if( gptCurrentTCB != OS_NULL )
+    {
+        ( gptCurrentTCB->uxMutexHoldNum )++;
+
+        ptMutex->ptNextHoldMutex = gptCurrentTCB->ptMutexHoldList;
+        gptCurrentTCB->ptMutexHoldList = ptMutex;
+        gptCurrentTCB->ptMutexPended = OS_NULL;
+    }
+    return gptCurrentTCB;
+}
+
+uOSBool_t OSTaskPriorityInherit( void * const pvMutex )
+{
+    tOSMutex_t * const ptMutex = ( tOSMutex_t * ) pvMutex;
+    tOSTCB_t * const ptMutexHolderTCB = ( tOSTCB_t * ) ptMutex->MutexHolderHandle;
+    const uOSBase_t uxPriority = gptCurrentTCB->uxPriority;
+    uOSBool_t bReturn = OS_FALSE;
+
+    /* Record the mutex the running task is going to block on, so that a
+    later inheritance can be passed on through this task. */
+    gptCurrentTCB->ptMutexPended = ptMutex;
+
+    if( ptMutexHolderTCB != OS_NULL )
+    {
+        /* Inheritance occurs now, or the holder has already inherited a
+        priority which is not lower than the priority of the running task. */
+        if( ptMutexHolderTCB->uxBasePriority < uxPriority )
+        {
             bReturn = OS_TRUE;
-            
+        }
+
+        OSTaskPriorityPropagate( ptMutexHolderTCB, uxPriority );
+    }
+    return bReturn;
+}
+
+uOSBool_t OSTaskPriorityDisinherit( OSTaskHandle_t const MutexHolderTaskHandle, void * const pvMutex )
+{
+    tOSTCB_t * const ptMutexHolderTCB = ( tOSTCB_t * ) MutexHolderTaskHandle;
+    tOSMutex_t * const ptMutex = ( tOSMutex_t * ) pvMutex;
+    tOSMutex_t ** pptMutex = OS_NULL;
+    uOSBase_t uxPriorityToUse = (uOSBase_t)0U;
+    uOSBool_t bNeedSchedule = OS_FALSE;
+
+    if( MutexHolderTaskHandle != OS_NULL )
+    {
+        ( ptMutexHolderTCB->uxMutexHoldNum )--;
+
+        /* Remove the mutex from the list of mutexes held by the task. */
+        for( pptMutex = &( ptMutexHolderTCB->ptMutexHoldList ); *pptMutex != OS_NULL; pptMutex = &( ( *pptMutex )->ptNextHoldMutex ) )
+        {
+            if( *pptMutex == ptMutex )
+            {
+                *pptMutex = ptMutex->ptNextHoldMutex;
+                break;
+            }
+        }
+        ptMutex->ptNextHoldMutex = OS_NULL;
+
+        /* Recompute the priority from the mutexes still held, rather than
+        falling back to the base priority. */
+        uxPriorityToUse = OSTaskGetInheritedPriority( ptMutexHolderTCB );
+
+        if( ptMutexHolderTCB->uxPriority != uxPriorityToUse )
+        {
+            OSTaskPriorityMove( ptMutexHolderTCB, uxPriorityToUse );
+
+            bNeedSchedule = OS_TRUE;
+        }
+    }
+
+    return bNeedSchedule;
+}
+
+void OSTaskPriorityDisinheritAfterTimeout( OSTaskHandle_t const MutexHolderTaskHandle )
+{
+    tOSTCB_t * ptMutexHolderTCB = ( tOSTCB_t * ) MutexHolderTaskHandle;
+    uOSBase_t uxPriorityToUse = (uOSBase_t)0U;
+    uOSBase_t uxDepth = ( uOSBase_t ) 0U;
+
+    /* The timed out task has already left the event list of the mutex, so
+    recompute the priority of the holder, and of every holder further down
+    the chain which inherited the same priority. */
+    while( ( ptMutexHolderTCB != OS_NULL ) && ( uxDepth < ( uOSBase_t ) OSMUTEX_INHERIT_DEPTH ) )
+    {
+        uxPriorityToUse = OSTaskGetInheritedPriority( ptMutexHolderTCB );
+
+        if( ptMutexHolderTCB->uxPriority == uxPriorityToUse )
+        {
+            break;
+        }
+
+        OSTaskPriorityMove( ptMutexHolderTCB, uxPriorityToUse );
+
+        ptMutexHolderTCB = OSTaskGetMutexPendedHolder( ptMutexHolderTCB );
+        uxDepth++;
+    }
+}
+
+#if ( OS_RWLOCK_ON!=0 )
+void *OSTaskGetRWLockWriter( void * const pvRWLock )
+{
+    tOSRWLock_t * const ptRWLock = ( tOSRWLock_t * ) pvRWLock;
+
+    if( gptCurrentTCB != OS_NULL )
+    {
+        ptRWLock->ptNextHoldRWLock = gptCurrentTCB->ptRWLockHoldList;
+        gptCurrentTCB->ptRWLockHoldList = ptRWLock;
+    }
+    return gptCurrentTCB;
+}
+
+uOSBool_t OSTaskPriorityInheritRWLock( OSTaskHandle_t const WriterTaskHandle )
+{
+    tOSTCB_t * const ptWriterTCB = ( tOSTCB_t * ) WriterTaskHandle;
+    uOSBool_t bReturn = OS_FALSE;
+
+    if( ptWriterTCB != OS_NULL )
+    {
+        if( ptWriterTCB->uxBasePriority < gptCurrentTCB->uxPriority )
+        {
+            bReturn = OS_TRUE;
+        }
+
+        OSTaskPriorityPropagate( ptWriterTCB, gptCurrentTCB->uxPriority );
+    }
+    return bReturn;
+}
+
+uOSBool_t OSTaskPriorityDisinheritRWLock( OSTaskHandle_t const WriterTaskHandle, void * const pvRWLock )
+{
+    tOSTCB_t * const ptWriterTCB = ( tOSTCB_t * ) WriterTaskHandle;
+    tOSRWLock_t * const ptRWLock = ( tOSRWLock_t * ) pvRWLock;
+    tOSRWLock_t ** pptRWLock = OS_NULL;
+    uOSBase_t uxPriorityToUse = (uOSBase_t)0U;
+    uOSBool_t bNeedSchedule = OS_FALSE;
+
+    if( WriterTaskHandle != OS_NULL )
+    {
+        /* Remove the RW lock from the list of locks written by the task. */
+        for( pptRWLock = &( ptWriterTCB->ptRWLockHoldList ); *pptRWLock != OS_NULL; pptRWLock = &( ( *pptRWLock )->ptNextHoldRWLock ) )
+        {
+            if( *pptRWLock == ptRWLock )
+            {
+                *pptRWLock = ptRWLock->ptNextHoldRWLock;
+                break;
+            }
+        }
+        ptRWLock->ptNextHoldRWLock = OS_NULL;
+
+        uxPriorityToUse = OSTaskGetInheritedPriority( ptWriterTCB );
+
+        if( ptWriterTCB->uxPriority != uxPriorityToUse )
+        {
+            OSTaskPriorityMove( ptWriterTCB, uxPriorityToUse );
+
+            bNeedSchedule = OS_TRUE;
+        }
+    }
+
+    return bNeedSchedule;
+}
+#endif /* ( OS_RWLOCK_ON!=0 ) */
+
+#if ( OS_MUTEX_CEILING_ON!=0 )
+void OSTaskPriorityCeiling( OSTaskHandle_t const MutexHolderTaskHandle, uOSBase_t uxCeilingPriority )
+{
+    tOSTCB_t * const ptMutexHolderTCB = ( tOSTCB_t * ) MutexHolderTaskHandle;
+
+    /* The holder runs at the ceiling straight away, so no task that may
+    take this mutex can preempt it while the mutex is held. */
+    if( MutexHolderTaskHandle != OS_NULL )
+    {
+        if( ptMutexHolderTCB->uxPriority < uxCeilingPriority )
+        {
+            OSTaskPriorityMove( ptMutexHolderTCB, uxCeilingPriority );
+        }
+    }
+}
+#endif /* ( OS_MUTEX_CEILING_ON!=0 ) */
+#endif /* ( OS_MUTEX_ON!=0 ) */
+
+#if ( OS_TASK_IPC_ON!=0 )
+/* Make a task blocked on a call ready, it may have timed out already. */
+static void OSTaskIPCWake( tOSTCB_t * const ptTCB )
+{
+    if( OSListContainListItem( &( gtOSTaskListReady[ ptTCB->uxPriority ] ), &( ptTCB->tTaskListItem ) ) == OS_FALSE )
+    {
+        ( void ) OSListRemoveItem( &( ptTCB->tTaskListItem ) );
+        OSTaskListReadyAdd( ptTCB );
+
+        OSUpdateUnblockTime();
+    }
+}
+
+static void OSTaskIPCDonate( tOSTCB_t * const ptServerTCB, uOSBase_t uxPriority )
+{
+    if( ptServerTCB->uxPriority < uxPriority )
+    {
+        OSTaskPriorityMove( ptServerTCB, uxPriority );
+    }
+}
+
+static void OSTaskIPCRestorePriority( tOSTCB_t * const ptServerTCB )
+{
+    uOSBase_t uxPriorityToUse = (uOSBase_t)0U;
+
+    #if ( OS_MUTEX_ON!= 0 )
+    {
+        uxPriorityToUse = OSTaskGetInheritedPriority( ptServerTCB );
+    }
+    #else
+    {
+        uxPriorityToUse = ptServerTCB->uxIPCBasePriority;
+    }
+    #endif
+
+    if( ptServerTCB->uxPriority != uxPriorityToUse )
+    {
+        OSTaskPriorityMove( ptServerTCB, uxPriorityToUse );
+    }
+}
+
+/* The server takes the call of the client, the message is copied once into
+the TCB of the server, which runs at the priority of the client until it
+replies. */
+static void OSTaskIPCAccept( tOSTCB_t * const ptServerTCB, tOSTCB_t * const ptClientTCB )
+{
+    if( OSListItemGetList( &( ptClientTCB->tEventListItem ) ) != OS_NULL )
+    {
+        ( void ) OSListRemoveItem( &( ptClientTCB->tEventListItem ) );
+    }
+    ptClientTCB->ucIPCState = IPC_STATE_REPLYWAIT;
+
+    ptServerTCB->uiIPCMsg = ptClientTCB->uiIPCMsg;
+    ptServerTCB->ptIPCPartner = ptClientTCB;
+    ptServerTCB->ucIPCState = IPC_STATE_SERVING;
+
+    #if ( OS_MUTEX_ON==0 )
+    {
+        ptServerTCB->uxIPCBasePriority = ptServerTCB->uxPriority;
+    }
+    #endif
+
+    OSTaskIPCDonate( ptServerTCB, ptClientTCB->uxPriority );
+    OSTaskIPCWake( ptServerTCB );
+}
+
+/* Send uiMsg to the server and block until it replies, the reply is written
+to puiReply. A server waiting in OSTaskReplyWait is switched to directly,
+otherwise the call waits in priority order for the server. */
+uOSBool_t OSTaskCall( OSTaskHandle_t const ServerHandle, uOS32_t const uiMsg, uOS32_t * const puiReply, uOSTick_t const uxTicksToWait )
+{
+    tOSTCB_t * const ptServerTCB = ( tOSTCB_t * ) ServerHandle;
+    tOSTCB_t * const ptTCB = gptCurrentTCB;
+    uOSBool_t bReturn = OS_FALSE;
+
+    if( ( ptServerTCB == OS_NULL ) || ( ptServerTCB == ptTCB ) || ( uxTicksToWait == ( uOSTick_t ) 0U ) )
+    {
+        return OS_FALSE;
+    }
+
+    OSIntLock();
+    {
+        ptTCB->uiIPCMsg = uiMsg;
+        ptTCB->ptIPCPartner = ptServerTCB;
+
+        if( ptServerTCB->ucIPCState == IPC_STATE_RECEIVING )
+        {
+            OSTaskIPCAccept( ptServerTCB, ptTCB );
+            gptIPCHandoffTCB = ptServerTCB;
         }
         else
         {
-            if( ptMutexHolderTCB->uxBasePriority < gptCurrentTCB->uxPriority )
+            ptTCB->ucIPCState = IPC_STATE_CALLING;
+            OSListInsertItem( &( ptServerTCB->tIPCCallList ), &( ptTCB->tEventListItem ) );
+
+            /* The call the server is busy with runs at the priority of
+            this client too. */
+            if( ptServerTCB->ucIPCState == IPC_STATE_SERVING )
             {
-                /* The base priority of the mutex holder is lower than the
-                priority of the task attempting to take the mutex, but the
-                current priority of the mutex holder is not lower than the
-                priority of the task attempting to take the mutex.
-                Therefore the mutex holder must have already inherited a
-                priority, but inheritance would have occurred if that had
-                not been the case. */
-                bReturn = OS_TRUE;
+                OSTaskIPCDonate( ptServerTCB, ptTCB->uxPriority );
+            }
+        }
+
+        OSTaskListPendAdd( ptTCB, uxTicksToWait, OS_TRUE );
+
+        OSSchedule();
+    }
+    OSIntUnlock();
+
+    OSIntLock();
+    {
+        /* A call timed out has already left the call list of the server,
+        a late reply is dropped. */
+        if( ptTCB->ucIPCState == IPC_STATE_REPLIED )
+        {
+            if( puiReply != OS_NULL )
+            {
+                *puiReply = ptTCB->uiIPCMsg;
+            }
+            bReturn = OS_TRUE;
+        }
+
+        ptTCB->ucIPCState = IPC_STATE_NONE;
+        ptTCB->ptIPCPartner = OS_NULL;
+    }
+    OSIntUnlock();
+
+    return bReturn;
+}
+
+/* Reply uiReply to ClientHandle if it is not OS_NULL, then wait for the next
+call. The client and its message are returned in pClientHandle and puiMsg,
+the server runs at the priority of the client until the next reply. */
+uOSBool_t OSTaskReplyWait( OSTaskHandle_t const ClientHandle, uOS32_t const uiReply, OSTaskHandle_t * const pClientHandle, uOS32_t * const puiMsg, uOSTick_t const uxTicksToWait )
+{
+    tOSTCB_t * ptClientTCB = ( tOSTCB_t * ) ClientHandle;
+    tOSTCB_t * const ptTCB = gptCurrentTCB;
+    uOSBool_t bReturn = OS_FALSE;
+
+    OSIntLock();
+    {
+        if( ptClientTCB != OS_NULL )
+        {
+            if( ( ptClientTCB->ucIPCState == IPC_STATE_REPLYWAIT ) && ( ptClientTCB->ptIPCPartner == ptTCB ) )
+            {
+                ptClientTCB->uiIPCMsg = uiReply;
+                ptClientTCB->ucIPCState = IPC_STATE_REPLIED;
+                OSTaskIPCWake( ptClientTCB );
+            }
+            else
+            {
+                /* The call timed out. */
+                ptClientTCB = OS_NULL;
+            }
+        }
+
+        ptTCB->ucIPCState = IPC_STATE_NONE;
+        ptTCB->ptIPCPartner = OS_NULL;
+        OSTaskIPCRestorePriority( ptTCB );
+
+        if( OSListIsEmpty( &( ptTCB->tIPCCallList ) ) == OS_FALSE )
+        {
+            OSTaskIPCAccept( ptTCB, ( tOSTCB_t * ) OSListGetHeadItemHolder( &( ptTCB->tIPCCallList ) ) );
+        }
+        else
+        {
+            ptTCB->ucIPCState = IPC_STATE_RECEIVING;
+
+            if( uxTicksToWait > ( uOSTick_t ) 0U )
+            {
+                OSTaskListPendAdd( ptTCB, uxTicksToWait, OS_TRUE );
+
+                /* The client replied to runs next. */
+                gptIPCHandoffTCB = ptClientTCB;
+                ptClientTCB = OS_NULL;
+
+                OSSchedule();
+            }
+        }
+
+        if( ptClientTCB != OS_NULL )
+        {
+            if( ptClientTCB->uxPriority > OSTaskGetPreemptPriority() )
+            {
+                OSSchedule();
+            }
+        }
+    }
+    OSIntUnlock();
+
+    OSIntLock();
+    {
+        if( ptTCB->ucIPCState == IPC_STATE_SERVING )
+        {
+            if( pClientHandle != OS_NULL )
+            {
+                *pClientHandle = ptTCB->ptIPCPartner;
             }
+            if( puiMsg != OS_NULL )
+            {
+                *puiMsg = ptTCB->uiIPCMsg;
+            }
+            bReturn = OS_TRUE;
+        }
+        else
+        {
+            ptTCB->ucIPCState = IPC_STATE_NONE;
         }
     }
-    return bReturn;
+    OSIntUnlock();
+
+    return bReturn;
+}
+#endif //( OS_TASK_IPC_ON!=0 )
+
+#if ( OS_STACK_WATERMARK_ON!=0 )
+uOSBase_t OSTaskGetStackHighWaterMark( OSTaskHandle_t const TaskHandle )
+{
+    tOSTCB_t *ptTCB = OS_NULL;
+
+    ptTCB = OSTaskGetTCBFromHandle( TaskHandle );
+
+    return OSTaskStackFreeBytes( ptTCB, ~( uOSBase_t ) 0U ) / ( uOSBase_t ) sizeof( uOSStack_t );
+}
+
+static uOSBase_t OSTaskStackReportList( tOSList_t * const ptList, tOSTaskStackInfo_t * const ptInfo, uOSBase_t uxNum, uOSBase_t uxMaxNum )
+{
+    const tOSListItem_t * ptListItem = OSListGetHeadItem( ptList );
+    tOSTCB_t * ptTCB = OS_NULL;
+
+    while( ( ptListItem != OSListGetEndMarkerItem( ptList ) ) && ( uxNum < uxMaxNum ) )
+    {
+        ptTCB = ( tOSTCB_t * ) OSListItemGetHolder( ptListItem );
+
+        ptInfo[ uxNum ].TaskHandle = ptTCB;
+        ptInfo[ uxNum ].pcTaskName = ptTCB->pcTaskName;
+        ptInfo[ uxNum ].uxPriority = ptTCB->uxPriority;
+        ptInfo[ uxNum ].uxStackHighWaterMark = OSTaskStackFreeBytes( ptTCB, ~( uOSBase_t ) 0U ) / ( uOSBase_t ) sizeof( uOSStack_t );
+        uxNum++;
+
+        ptListItem = OSListItemGetNextItem( ptListItem );
+    }
+
+    return uxNum;
+}
+
+uOSBase_t OSTaskStackReport( tOSTaskStackInfo_t * const ptInfo, uOSBase_t uxMaxNum )
+{
+    uOSBase_t uxNum = ( uOSBase_t ) 0U;
+    uOSBase_t uxPriority = ( uOSBase_t ) 0U;
+
+    /* Every task is in a ready, pend or suspended list through its task list
+    item, the lists are stable while the scheduler is locked. */
+    OSScheduleLock();
+    {
+        for( uxPriority = ( uOSBase_t ) 0U; uxPriority < ( uOSBase_t ) OSHIGHEAST_PRIORITY; uxPriority++ )
+        {
+            uxNum = OSTaskStackReportList( &( gtOSTaskListReady[ uxPriority ] ), ptInfo, uxNum, uxMaxNum );
+        }
+        uxNum = OSTaskStackReportList( &gtOSTaskListPend1, ptInfo, uxNum, uxMaxNum );
+        uxNum = OSTaskStackReportList( &gtOSTaskListPend2, ptInfo, uxNum, uxMaxNum );
+        uxNum = OSTaskStackReportList( &gptOSTaskListSuspended, ptInfo, uxNum, uxMaxNum );
+    }
+    ( void ) OSScheduleUnlock();
+
+    return uxNum;
+}
+#endif //( OS_STACK_WATERMARK_ON!=0 )
+
+#if ( OS_TASK_BUDGET_ON!=0 )
+/* Charge uxTicks to the budget of the running task, called from the tick
+with the scheduler unlocked. A task out of budget sleeps until its next
+period starts, returns OS_TRUE then. */
+uOSBool_t OSTaskBudgetCharge( const uOSTick_t uxTickCount, const uOSTick_t uxTicks )
+{
+    tOSTCB_t * const ptTCB = gptCurrentTCB;
+    uOSTick_t uxElapsed = ( uOSTick_t ) 0U;
+
+    if( ptTCB->uxBudgetTicks == ( uOSTick_t ) 0U )
+    {
+        return OS_FALSE;
+    }
+
+    uxElapsed = uxTickCount - ptTCB->uxBudgetPeriodStart;
+    if( uxElapsed >= ptTCB->uxBudgetPeriod )
+    {
+        /* Replenish, the period restarts now if the task did not run when
+        it was due. */
+        ptTCB->uxBudgetPeriodStart = uxTickCount;
+        ptTCB->uxBudgetLeft = ptTCB->uxBudgetTicks;
+        uxElapsed = ( uOSTick_t ) 0U;
+    }
+
+    if( ptTCB->uxBudgetLeft > uxTicks )
+    {
+        ptTCB->uxBudgetLeft -= uxTicks;
+        return OS_FALSE;
+    }
+    ptTCB->uxBudgetLeft = ( uOSTick_t ) 0U;
+
+    /* The task may have blocked already, only a ready task is parked. */
+    if( OSListContainListItem( &( gtOSTaskListReady[ ptTCB->uxPriority ] ), &( ptTCB->tTaskListItem ) ) == OS_FALSE )
+    {
+        return OS_FALSE;
+    }
+
+    OSTaskBudgetHook( ptTCB, ptTCB->pcTaskName );
+    OSTaskListPendInsert( ptTCB, uxTickCount, ptTCB->uxBudgetPeriod - uxElapsed, OS_FALSE );
+
+    return OS_TRUE;
 }
 
-uOSBool_t OSTaskPriorityDisinherit( OSTaskHandle_t const MutexHolderTaskHandle )
+/* Let the task run uxBudgetTicks in every uxPeriodTicks, a budget of 0 removes
+the limit. Do not give the idle task a budget, a task out of budget keeps the
+mutexes it holds. */
+void OSTaskSetBudget( OSTaskHandle_t const TaskHandle, uOSTick_t uxBudgetTicks, uOSTick_t uxPeriodTicks )
 {
-    tOSTCB_t * const ptMutexHolderTCB = ( tOSTCB_t * ) MutexHolderTaskHandle;
-    uOSBool_t bNeedSchedule = OS_FALSE;
+    tOSTCB_t *ptTCB = OS_NULL;
+    const uOSTick_t uxTickCount = OSGetTickCount();
 
-    if( MutexHolderTaskHandle != OS_NULL )
+    if( uxBudgetTicks > uxPeriodTicks )
     {
-        ( ptMutexHolderTCB->uxMutexHoldNum )--;
-
-        if( ptMutexHolderTCB->uxPriority != ptMutexHolderTCB->uxBasePriority )
-        {
-            if( ptMutexHolderTCB->uxMutexHoldNum == ( uOSBase_t ) 0U )
-            {
-                if( OSListRemoveItem( &( ptMutexHolderTCB->tTaskListItem ) ) == ( uOSBase_t ) 0U )
-                {
-                    OSResetReadyPriority( ptMutexHolderTCB->uxPriority );
-                }
+        uxBudgetTicks = uxPeriodTicks;
+    }
 
-                ptMutexHolderTCB->uxPriority = ptMutexHolderTCB->uxBasePriority;
+    OSIntLock();
+    {
+        ptTCB = OSTaskGetTCBFromHandle( TaskHandle );
+        ptTCB->uxBudgetTicks = uxBudgetTicks;
+        ptTCB->uxBudgetPeriod = uxPeriodTicks;
+        ptTCB->uxBudgetPeriodStart = uxTickCount;
+        ptTCB->uxBudgetLeft = uxBudgetTicks;
+    }
+    OSIntUnlock();
+}
 
-                OSListItemSetValue( &( ptMutexHolderTCB->tEventListItem ), ( uOSTick_t ) OSHIGHEAST_PRIORITY - ( uOSTick_t ) ptMutexHolderTCB->uxPriority );
-                OSTaskListReadyAdd( ptMutexHolderTCB );
+uOSTick_t OSTaskGetBudgetLeft( OSTaskHandle_t const TaskHandle )
+{
+    tOSTCB_t *ptTCB = OS_NULL;
+    uOSTick_t uxReturn = ( uOSTick_t ) 0U;
 
-                bNeedSchedule = OS_TRUE;
-            }
-        }
+    OSIntLock();
+    {
+        ptTCB = OSTaskGetTCBFromHandle( TaskHandle );
+        uxReturn = ptTCB->uxBudgetLeft;
     }
+    OSIntUnlock();
 
-    return bNeedSchedule;
+    return uxReturn;
 }
+#endif //( OS_TASK_BUDGET_ON!=0 )
 
-void OSTaskPriorityDisinheritAfterTimeout( OSTaskHandle_t const MutexHolderTaskHandle, uOSBase_t uxHighestPriorityWaitingTask )
+#if (OSTIME_SLICE_ON != 0U)
+/* Count uxTicks off the turn of the running task, once the turn is over
+the next ready task of the same priority runs. */
+uOSBool_t OSTaskNeedTimeSlice( const uOSTick_t uxTicks )
 {
-    tOSTCB_t * const ptMutexHolderTCB = ( tOSTCB_t * ) MutexHolderTaskHandle;
-    uOSBase_t uxPriorityUsedOnEntry = (uOSBase_t)0U;
-    uOSBase_t uxPriorityToUse = (uOSBase_t)0U;
-    const uOSBase_t uxOnlyOneMutexHeld = ( uOSBase_t ) 1U;
+    uOSBool_t bReturn = OS_FALSE;
 
-    if( MutexHolderTaskHandle != NULL )
+    if( gptCurrentTCB->uxTimeSliceTicks != ( uOSTick_t ) 0U )
     {
-        /* Determine the priority to which the priority of the task that
-        holds the mutex should be set.  This will be the greater of the
-        holding task's base priority and the priority of the highest
-        priority task that is waiting to obtain the mutex. */
-        if( ptMutexHolderTCB->uxBasePriority < uxHighestPriorityWaitingTask )
+        if( gptCurrentTCB->uxTimeSliceLeft > uxTicks )
         {
-            uxPriorityToUse = uxHighestPriorityWaitingTask;
+            gptCurrentTCB->uxTimeSliceLeft -= uxTicks;
         }
         else
         {
-            uxPriorityToUse = ptMutexHolderTCB->uxBasePriority;
+            gptCurrentTCB->uxTimeSliceLeft = gptCurrentTCB->uxTimeSliceTicks;
+            bReturn = (uOSBool_t)(OSListGetLength( &( gtOSTaskListReady[ gptCurrentTCB->uxPriority ] ) ) > 1U);
         }
+    }
 
-        /* Does the priority need to change? */
-        if( ptMutexHolderTCB->uxPriority != uxPriorityToUse )
-        {
-            /* Only disinherit if no other mutexes are held.  This is a
-            simplification in the priority inheritance implementation.  If
-            the task that holds the mutex is also holding other mutexes then
-            the other mutexes may have caused the priority inheritance. */
-            if( ptMutexHolderTCB->uxMutexHoldNum == uxOnlyOneMutexHeld )
-            {
-                uxPriorityUsedOnEntry = ptMutexHolderTCB->uxPriority;
-                ptMutexHolderTCB->uxPriority = uxPriorityToUse;
-
-                /* Only reset the event list item value if the value is not
-                being used for anything else. */
-                if( OSListItemGetValue( &( ptMutexHolderTCB->tEventListItem ) ) == 0UL )
-                {
-                    OSListItemSetValue( &( ptMutexHolderTCB->tEventListItem ), ( uOSTick_t ) OSHIGHEAST_PRIORITY - ( uOSTick_t ) uxPriorityToUse ); 
-                }
+    return bReturn;
+}
 
-                /* If the running task is not the task that holds the mutex
-                then the task that holds the mutex could be in either the
-                Ready, Blocked or Suspended states.  Only remove the task
-                from its current state list if it is in the Ready state as
-                the task's priority is going to change and there is one
-                Ready list per priority. */
-                if( OSListContainListItem( &( gtOSTaskListReady[ uxPriorityUsedOnEntry ] ), &( ptMutexHolderTCB->tTaskListItem ) ) != OS_FALSE )
-                {
-                    if( OSListRemoveItem( &( ptMutexHolderTCB->tTaskListItem ) ) == ( uOSBase_t ) 0 )
-                    {
-                        OSResetReadyPriority( ptMutexHolderTCB->uxPriority );
-                    }
+/* Set the ticks of a turn of the task, 0 to run the task until it blocks or yields. */
+void OSTaskSetTimeSlice( OSTaskHandle_t const TaskHandle, uOSTick_t uxTicks )
+{
+    tOSTCB_t *ptTCB = OS_NULL;
 
-                    OSTaskListReadyAdd( ptMutexHolderTCB );
-                }
-            }
-        }
+    OSIntLock();
+    {
+        ptTCB = OSTaskGetTCBFromHandle( TaskHandle );
+        ptTCB->uxTimeSliceTicks = uxTicks;
+        ptTCB->uxTimeSliceLeft = uxTicks;
     }
+    OSIntUnlock();
 }
-#endif /* ( OS_MUTEX_ON!=0 ) */
 
-#if (OSTIME_SLICE_ON != 0U)
-uOSBool_t OSTaskNeedTimeSlice( void )
+uOSTick_t OSTaskGetTimeSlice( OSTaskHandle_t const TaskHandle )
 {
-    return (uOSBool_t)(OSListGetLength( &( gtOSTaskListReady[ gptCurrentTCB-> uxPriority ] ) )>0U);
+    tOSTCB_t *ptTCB = OS_NULL;
+    uOSTick_t uxReturn = ( uOSTick_t ) 0U;
+
+    OSIntLock();
+    {
+        ptTCB = OSTaskGetTCBFromHandle( TaskHandle );
+        uxReturn = ptTCB->uxTimeSliceTicks;
+    }
+    OSIntUnlock();
+
+    return uxReturn;
 }
 #endif //(OSTIME_SLICE_ON != 0U)
 
@@ -900,11 +1985,16 @@ void OSTaskSuspend( OSTaskHandle_t TaskHandle )
 
         #if( OS_TASK_SIGNAL_ON!=0 )
         {
-            if( ptTCB->ucSigState == SIG_STATE_WAITING )
+            uOSBase_t x = ( uOSBase_t ) 0;
+
+            for( x = ( uOSBase_t ) 0; x < ( uOSBase_t ) OSTASK_SIGNAL_SLOTS; x++ )
             {
-                /* The task was blocked to wait for a signal, but is
-                now suspended, so no signal was received. */
-                ptTCB->ucSigState = SIG_STATE_NOTWAITING;
+                if( ptTCB->ucSigState[ x ] == SIG_STATE_WAITING )
+                {
+                    /* The task was blocked to wait for a signal, but is
+                    now suspended, so no signal was received. */
+                    ptTCB->ucSigState[ x ] = SIG_STATE_NOTWAITING;
+                }
             }
         }
         #endif
@@ -978,7 +2068,7 @@ void OSTaskResume( OSTaskHandle_t TaskHandle )
                 ( void ) OSListRemoveItem(  &( ptTCB->tTaskListItem ) );
                 OSTaskListReadyAdd( ptTCB );
 
-                if( ptTCB->uxPriority >= gptCurrentTCB->uxPriority )
+                if( ptTCB->uxPriority >= OSTaskGetMinPreemptPriority() )
                 {
                     OSSchedule();
                 }
@@ -999,12 +2089,16 @@ sOSBase_t OSTaskResumeFromISR( OSTaskHandle_t TaskHandle )
     {
         if( OSTaskIsSuspended( ptTCB ) != OS_FALSE )
         {
+            #if ( OS_LATENCY_TRACE_ON!=0 )
+            OSTaskLatencyMark( ptTCB );
+            #endif //( OS_LATENCY_TRACE_ON!=0 )
+
             /* Check the ready lists can be accessed. */
             if( OSScheduleIsLocked() == OS_FALSE )
             {
                 /* Ready lists can be accessed so move the task from the
                 suspended list to the ready list directly. */
-                if( ptTCB->uxPriority >= gptCurrentTCB->uxPriority )
+                if( ptTCB->uxPriority >= OSTaskGetMinPreemptPriority() )
                 {
                     bNeedSchedule = OS_TRUE;
                 }
@@ -1044,13 +2138,19 @@ void OSIdleTask( void *pvParameters)
     /* Just to avoid compiler warnings. */
     ( void ) pvParameters;
     
+    #if ( OS_COOPERATIVE_ON!=0 )
+    {
+        gptIdleTCB = gptCurrentTCB;
+    }
+    #endif //( OS_COOPERATIVE_ON!=0 )
+
     for( ;; )
     {
         // if there is not any other task ready, then OS enter idle task;
 
         if( OSListGetLength( &( gtOSTaskListReady[ OSLOWEAST_PRIORITY ] ) ) > ( uOSBase_t ) 1 )
         {
-            OSSchedule();
+            OSTaskYield();
         }
         
         #if ( OS_MEMFREE_ON != 0 )         
@@ -1095,10 +2195,10 @@ uOSBool_t OSTaskSignalWait( uOSTick_t const uxTicksToWait)
     OSIntLock();
     {
         /* Only block if the signal count is not already non-zero. */
-        if( gptCurrentTCB->uiSigValue == 0UL )
+        if( gptCurrentTCB->uiSigValue[ 0 ] == 0UL )
         {
             /* Mark this task as waiting for a signal. */
-            gptCurrentTCB->ucSigState = SIG_STATE_WAITING;
+            gptCurrentTCB->ucSigState[ 0 ] = SIG_STATE_WAITING;
 
             if( uxTicksToWait > ( uOSTick_t ) 0 )
             {
@@ -1112,16 +2212,16 @@ uOSBool_t OSTaskSignalWait( uOSTick_t const uxTicksToWait)
 
     OSIntLock();
     {
-        xTemp = gptCurrentTCB->uiSigValue;
+        xTemp = gptCurrentTCB->uiSigValue[ 0 ];
 
         if( (uOS32_t)xTemp > 0UL )
         {
-            gptCurrentTCB->uiSigValue = xTemp - (uOSBase_t)1;
+            gptCurrentTCB->uiSigValue[ 0 ] = xTemp - (uOSBase_t)1;
             
             bReturn = OS_TRUE;
         }
 
-        gptCurrentTCB->ucSigState = SIG_STATE_NOTWAITING;
+        gptCurrentTCB->ucSigState[ 0 ] = SIG_STATE_NOTWAITING;
     }
     OSIntUnlock();
 
@@ -1137,16 +2237,16 @@ uOSBool_t OSTaskSignalEmit( OSTaskHandle_t const TaskHandle )
 
     OSIntLock();
     {
-        ucOldState = ptTCB->ucSigState;
+        ucOldState = ptTCB->ucSigState[ 0 ];
 
-        ptTCB->ucSigState = SIG_STATE_RECEIVED;
-        if( ptTCB->uiSigValue>0xF )
+        ptTCB->ucSigState[ 0 ] = SIG_STATE_RECEIVED;
+        if( ptTCB->uiSigValue[ 0 ]>0xF )
         {
             bReturn = OS_FALSE;
         }
         else
         {
-            ptTCB->uiSigValue += 1;
+            ptTCB->uiSigValue[ 0 ] += 1;
             bReturn = OS_TRUE;
         }
         /* If the task is in the blocked state specifically to wait for a
@@ -1158,7 +2258,7 @@ uOSBool_t OSTaskSignalEmit( OSTaskHandle_t const TaskHandle )
 
             OSUpdateUnblockTime();
 
-            if( ptTCB->uxPriority > gptCurrentTCB->uxPriority )
+            if( ptTCB->uxPriority > OSTaskGetPreemptPriority() )
             {
                 /* The signaled task has a priority above the currently
                 executing task so schedule is required. */
@@ -1182,16 +2282,16 @@ uOSBool_t OSTaskSignalEmitFromISR( OSTaskHandle_t const TaskHandle )
 
     uxIntSave = OSIntMaskFromISR();
     {
-        ucOldState = ptTCB->ucSigState;
-        ptTCB->ucSigState = SIG_STATE_RECEIVED;
+        ucOldState = ptTCB->ucSigState[ 0 ];
+        ptTCB->ucSigState[ 0 ] = SIG_STATE_RECEIVED;
 
-        if( ptTCB->uiSigValue>0xF )
+        if( ptTCB->uiSigValue[ 0 ]>0xF )
         {
             bReturn = OS_FALSE;
         }
         else
         {
-            ptTCB->uiSigValue += 1;
+            ptTCB->uiSigValue[ 0 ] += 1;
             bReturn = OS_TRUE;
         }
 
@@ -1199,6 +2299,10 @@ uOSBool_t OSTaskSignalEmitFromISR( OSTaskHandle_t const TaskHandle )
         signal then unblock it now. */
         if( ucOldState == SIG_STATE_WAITING )
         {
+            #if ( OS_LATENCY_TRACE_ON!=0 )
+            OSTaskLatencyMark( ptTCB );
+            #endif //( OS_LATENCY_TRACE_ON!=0 )
+
             /* The task should not have been on an event list. */
             if( OSScheduleIsLocked() == OS_FALSE )
             {
@@ -1212,7 +2316,7 @@ uOSBool_t OSTaskSignalEmitFromISR( OSTaskHandle_t const TaskHandle )
                 OSListInsertItemToEnd( &( gtOSTaskListReadyPool ), &( ptTCB->tEventListItem ) );
             }
 
-            if( ptTCB->uxPriority > gptCurrentTCB->uxPriority )
+            if( ptTCB->uxPriority > OSTaskGetPreemptPriority() )
             {
                 /* The signaled task has a priority above the currently
                 executing task so schedule is required. */
@@ -1235,13 +2339,13 @@ uOSBool_t OSTaskSignalWaitMsg( uOS32_t* puiSigValue, uOSTick_t const uxTicksToWa
     OSIntLock();
     {
         /* Only block if a signal is not already pending. */
-        if( gptCurrentTCB->ucSigState != SIG_STATE_RECEIVED )
+        if( gptCurrentTCB->ucSigState[ 0 ] != SIG_STATE_RECEIVED )
         {
             /* clear the value to zero. */
-            gptCurrentTCB->uiSigValue = 0;
+            gptCurrentTCB->uiSigValue[ 0 ] = 0;
 
             /* Mark this task as waiting for a signal. */
-            gptCurrentTCB->ucSigState = SIG_STATE_WAITING;
+            gptCurrentTCB->ucSigState[ 0 ] = SIG_STATE_WAITING;
 
             if( uxTicksToWait > ( uOSTick_t ) 0 )
             {
@@ -1262,14 +2366,14 @@ uOSBool_t OSTaskSignalWaitMsg( uOS32_t* puiSigValue, uOSTick_t const uxTicksToWa
         if( puiSigValue != OS_NULL )
         {
             /* Output the current signal value. */
-            *puiSigValue = gptCurrentTCB->uiSigValue;
+            *puiSigValue = gptCurrentTCB->uiSigValue[ 0 ];
         }
 
         /* If uiSigValue is set then either the task never entered the
         blocked state (because a signal was already pending) or the
         task unblocked because of a signal.  Otherwise the task
         unblocked because of a timeout. */
-        if( gptCurrentTCB->ucSigState != SIG_STATE_RECEIVED )
+        if( gptCurrentTCB->ucSigState[ 0 ] != SIG_STATE_RECEIVED )
         {
             /* A signal was not received. */
             bReturn = OS_FALSE;
@@ -1278,11 +2382,11 @@ uOSBool_t OSTaskSignalWaitMsg( uOS32_t* puiSigValue, uOSTick_t const uxTicksToWa
         {
             /* A signal was already pending or a signal was
             received while the task was waiting. */
-            gptCurrentTCB->uiSigValue = 0;
+            gptCurrentTCB->uiSigValue[ 0 ] = 0;
             bReturn = OS_TRUE;
         }
 
-        gptCurrentTCB->ucSigState = SIG_STATE_NOTWAITING;
+        gptCurrentTCB->ucSigState[ 0 ] = SIG_STATE_NOTWAITING;
     }
     OSIntUnlock();
 
@@ -1298,12 +2402,12 @@ uOSBool_t OSTaskSignalEmitMsg( OSTaskHandle_t const TaskHandle, uOS32_t const ui
 
     OSIntLock();
     {
-        ucOldState = ptTCB->ucSigState;
+        ucOldState = ptTCB->ucSigState[ 0 ];
 
-        ptTCB->ucSigState = SIG_STATE_RECEIVED;
+        ptTCB->ucSigState[ 0 ] = SIG_STATE_RECEIVED;
         if( ucOldState != SIG_STATE_RECEIVED || bOverWrite == OS_TRUE )
         {
-            ptTCB->uiSigValue = uiSigValue;
+            ptTCB->uiSigValue[ 0 ] = uiSigValue;
             bReturn = OS_TRUE;
         }
         else
@@ -1321,7 +2425,7 @@ uOSBool_t OSTaskSignalEmitMsg( OSTaskHandle_t const TaskHandle, uOS32_t const ui
 
             OSUpdateUnblockTime();
 
-            if( ptTCB->uxPriority > gptCurrentTCB->uxPriority )
+            if( ptTCB->uxPriority > OSTaskGetPreemptPriority() )
             {
                 /* The signaled task has a priority above the currently
                 executing task so schedule is required. */
@@ -1345,11 +2449,11 @@ uOSBool_t OSTaskSignalEmitMsgFromISR( OSTaskHandle_t const TaskHandle, uOS32_t c
 
     uxIntSave = OSIntMaskFromISR();
     {
-        ucOldState = ptTCB->ucSigState;
-        ptTCB->ucSigState = SIG_STATE_RECEIVED;
+        ucOldState = ptTCB->ucSigState[ 0 ];
+        ptTCB->ucSigState[ 0 ] = SIG_STATE_RECEIVED;
         if( ucOldState != SIG_STATE_RECEIVED || bOverWrite == OS_TRUE )
         {
-            ptTCB->uiSigValue = uiSigValue;
+            ptTCB->uiSigValue[ 0 ] = uiSigValue;
             bReturn = OS_TRUE;
         }
         else
@@ -1362,6 +2466,10 @@ uOSBool_t OSTaskSignalEmitMsgFromISR( OSTaskHandle_t const TaskHandle, uOS32_t c
         signal then unblock it now. */
         if( ucOldState == SIG_STATE_WAITING )
         {
+            #if ( OS_LATENCY_TRACE_ON!=0 )
+            OSTaskLatencyMark( ptTCB );
+            #endif //( OS_LATENCY_TRACE_ON!=0 )
+
             if( OSScheduleIsLocked() == OS_FALSE )
             {
                 ( void ) OSListRemoveItem( &( ptTCB->tTaskListItem ) );
@@ -1374,7 +2482,7 @@ uOSBool_t OSTaskSignalEmitMsgFromISR( OSTaskHandle_t const TaskHandle, uOS32_t c
                 OSListInsertItemToEnd( &( gtOSTaskListReadyPool ), &( ptTCB->tEventListItem ) );
             }
 
-            if( ptTCB->uxPriority > gptCurrentTCB->uxPriority )
+            if( ptTCB->uxPriority > OSTaskGetPreemptPriority() )
             {
                 /* The signaled task has a priority above the currently
                 executing task so schedule is required. */
@@ -1402,10 +2510,10 @@ uOSBool_t OSTaskSignalClear( OSTaskHandle_t const TaskHandle )
 
     OSIntLock();
     {
-        if( ptTCB->ucSigState == SIG_STATE_RECEIVED )
+        if( ptTCB->ucSigState[ 0 ] == SIG_STATE_RECEIVED )
         {
-            ptTCB->ucSigState = SIG_STATE_NOTWAITING;
-            ptTCB->uiSigValue = 0;
+            ptTCB->ucSigState[ 0 ] = SIG_STATE_NOTWAITING;
+            ptTCB->uiSigValue[ 0 ] = 0;
             bReturn = OS_TRUE;
         }
         else
@@ -1417,6 +2525,232 @@ uOSBool_t OSTaskSignalClear( OSTaskHandle_t const TaskHandle )
 
     return bReturn;    
 }
+
+static uOSBool_t OSTaskSignalApply( tOSTCB_t * const ptTCB, uOSBase_t uxIndex, uOS32_t const uiSigValue, eOSSigAction_t eAction, uOS8_t ucOldState )
+{
+    uOSBool_t bReturn = OS_TRUE;
+
+    switch( eAction )
+    {
+        case eSigActionSetBits:
+            ptTCB->uiSigValue[ uxIndex ] |= uiSigValue;
+            break;
+
+        case eSigActionIncrement:
+            ( ptTCB->uiSigValue[ uxIndex ] )++;
+            break;
+
+        case eSigActionOverwrite:
+            ptTCB->uiSigValue[ uxIndex ] = uiSigValue;
+            break;
+
+        case eSigActionSetIfEmpty:
+            if( ucOldState != SIG_STATE_RECEIVED )
+            {
+                ptTCB->uiSigValue[ uxIndex ] = uiSigValue;
+            }
+            else
+            {
+                /* The value could not be written to the task. */
+                bReturn = OS_FALSE;
+            }
+            break;
+
+        case eSigActionNone:
+        default:
+            break;
+    }
+
+    return bReturn;
+}
+
+uOSBool_t OSTaskSignalWaitIndexed( uOSBase_t uxIndex, uOS32_t uiClearOnEntry, uOS32_t uiClearOnExit, uOS32_t* puiSigValue, uOSTick_t const uxTicksToWait )
+{
+    uOSBool_t bReturn = OS_FALSE;
+
+    if( uxIndex >= ( uOSBase_t ) OSTASK_SIGNAL_SLOTS )
+    {
+        return OS_FALSE;
+    }
+
+    OSIntLock();
+    {
+        /* Only block if a signal is not already pending. */
+        if( gptCurrentTCB->ucSigState[ uxIndex ] != SIG_STATE_RECEIVED )
+        {
+            /* Clear the bits which the caller does not want to keep. */
+            gptCurrentTCB->uiSigValue[ uxIndex ] &= ~uiClearOnEntry;
+
+            /* Mark this task as waiting for a signal on this slot. */
+            gptCurrentTCB->ucSigState[ uxIndex ] = SIG_STATE_WAITING;
+
+            if( uxTicksToWait > ( uOSTick_t ) 0 )
+            {
+                OSTaskListPendAdd( gptCurrentTCB, uxTicksToWait, OS_TRUE );
+
+                OSSchedule();
+            }
+        }
+    }
+    OSIntUnlock();
+
+    OSIntLock();
+    {
+        if( puiSigValue != OS_NULL )
+        {
+            /* Output the signal value before the exit mask is applied. */
+            *puiSigValue = gptCurrentTCB->uiSigValue[ uxIndex ];
+        }
+
+        if( gptCurrentTCB->ucSigState[ uxIndex ] != SIG_STATE_RECEIVED )
+        {
+            /* A signal was not received. */
+            bReturn = OS_FALSE;
+        }
+        else
+        {
+            gptCurrentTCB->uiSigValue[ uxIndex ] &= ~uiClearOnExit;
+            bReturn = OS_TRUE;
+        }
+
+        gptCurrentTCB->ucSigState[ uxIndex ] = SIG_STATE_NOTWAITING;
+    }
+    OSIntUnlock();
+
+    return bReturn;
+}
+
+uOSBool_t OSTaskSignalEmitIndexed( OSTaskHandle_t const TaskHandle, uOSBase_t uxIndex, uOS32_t const uiSigValue, eOSSigAction_t eAction )
+{
+    tOSTCB_t * ptTCB = OS_NULL;
+    uOSBool_t bReturn = OS_FALSE;
+    uOS8_t ucOldState = SIG_STATE_NOTWAITING;
+
+    if( uxIndex >= ( uOSBase_t ) OSTASK_SIGNAL_SLOTS )
+    {
+        return OS_FALSE;
+    }
+
+    ptTCB = ( tOSTCB_t * ) TaskHandle;
+
+    OSIntLock();
+    {
+        ucOldState = ptTCB->ucSigState[ uxIndex ];
+
+        bReturn = OSTaskSignalApply( ptTCB, uxIndex, uiSigValue, eAction, ucOldState );
+        ptTCB->ucSigState[ uxIndex ] = SIG_STATE_RECEIVED;
+
+        /* If the task is in the blocked state specifically to wait for a
+        signal on this slot then unblock it now. */
+        if( ucOldState == SIG_STATE_WAITING )
+        {
+            ( void ) OSListRemoveItem( &( ptTCB->tTaskListItem ) );
+            OSTaskListReadyAdd( ptTCB );
+
+            OSUpdateUnblockTime();
+
+            if( ptTCB->uxPriority > OSTaskGetPreemptPriority() )
+            {
+                /* The signaled task has a priority above the currently
+                executing task so schedule is required. */
+                OSSchedule();
+            }
+        }
+    }
+    OSIntUnlock();
+
+    return bReturn;
+}
+
+uOSBool_t OSTaskSignalEmitIndexedFromISR( OSTaskHandle_t const TaskHandle, uOSBase_t uxIndex, uOS32_t const uiSigValue, eOSSigAction_t eAction )
+{
+    tOSTCB_t * ptTCB = OS_NULL;
+    uOS8_t ucOldState = SIG_STATE_NOTWAITING;
+    uOSBool_t bReturn = OS_FALSE;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+    uOSBool_t bNeedSchedule = OS_FALSE;
+
+    if( uxIndex >= ( uOSBase_t ) OSTASK_SIGNAL_SLOTS )
+    {
+        return OS_FALSE;
+    }
+
+    ptTCB = ( tOSTCB_t * ) TaskHandle;
+
+    uxIntSave = OSIntMaskFromISR();
+    {
+        ucOldState = ptTCB->ucSigState[ uxIndex ];
+
+        bReturn = OSTaskSignalApply( ptTCB, uxIndex, uiSigValue, eAction, ucOldState );
+        ptTCB->ucSigState[ uxIndex ] = SIG_STATE_RECEIVED;
+
+        /* If the task is in the blocked state specifically to wait for a
+        signal on this slot then unblock it now. */
+        if( ucOldState == SIG_STATE_WAITING )
+        {
+            #if ( OS_LATENCY_TRACE_ON!=0 )
+            OSTaskLatencyMark( ptTCB );
+            #endif //( OS_LATENCY_TRACE_ON!=0 )
+
+            if( OSScheduleIsLocked() == OS_FALSE )
+            {
+                ( void ) OSListRemoveItem( &( ptTCB->tTaskListItem ) );
+                OSTaskListReadyAdd( ptTCB );
+            }
+            else
+            {
+                /* The timer and ready lists cannot be accessed, so hold
+                this task pending until the scheduler is resumed. */
+                OSListInsertItemToEnd( &( gtOSTaskListReadyPool ), &( ptTCB->tEventListItem ) );
+            }
+
+            if( ptTCB->uxPriority > OSTaskGetPreemptPriority() )
+            {
+                /* The signaled task has a priority above the currently
+                executing task so schedule is required. */
+                bNeedSchedule = OS_TRUE;
+            }
+        }
+    }
+    OSIntUnmaskFromISR( uxIntSave );
+
+    if(bNeedSchedule == OS_TRUE)
+    {
+        OSSchedule();
+    }
+    return bReturn;
+}
+
+uOS32_t OSTaskSignalClearIndexed( OSTaskHandle_t const TaskHandle, uOSBase_t uxIndex, uOS32_t uiClearMask )
+{
+    tOSTCB_t *ptTCB = OS_NULL;
+    uOS32_t uiSigValue = 0;
+
+    if( uxIndex >= ( uOSBase_t ) OSTASK_SIGNAL_SLOTS )
+    {
+        return 0;
+    }
+
+    /* If null is passed in here then it is the calling task that is having
+    its signal value cleared. */
+    ptTCB = OSTaskGetTCBFromHandle( TaskHandle );
+
+    OSIntLock();
+    {
+        /* Return the value before the bits are cleared. */
+        uiSigValue = ptTCB->uiSigValue[ uxIndex ];
+        ptTCB->uiSigValue[ uxIndex ] &= ~uiClearMask;
+
+        /* A pending signal is dropped once no bit of it is left. */
+        if( ( ptTCB->ucSigState[ uxIndex ] == SIG_STATE_RECEIVED ) && ( ptTCB->uiSigValue[ uxIndex ] == 0UL ) )
+        {
+            ptTCB->ucSigState[ uxIndex ] = SIG_STATE_NOTWAITING;
+        }
+    }
+    OSIntUnlock();
+
+    return uiSigValue;
+}
 #endif
 
 #ifdef __cplusplus
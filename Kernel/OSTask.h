@@ -58,6 +58,17 @@ typedef enum
     eTaskStateNum
 }eOSTaskState_t;
 
+#if ( OS_TASK_SIGNAL_ON!=0 )
+typedef enum
+{
+    eSigActionNone = 0,         /*< Wake the task only, the signal value is unchanged. */
+    eSigActionSetBits   ,       /*< OR the value into the signal value. */
+    eSigActionIncrement ,       /*< Increment the signal value, the value is ignored. */
+    eSigActionOverwrite ,       /*< Write the value even if a signal is pending. */
+    eSigActionSetIfEmpty        /*< Write the value only if no signal is pending. */
+}eOSSigAction_t;
+#endif //( OS_TASK_SIGNAL_ON!=0 )
+
 /*
  * Task control block.  A task control block (TCB) is allocated for each task,
  * and stores task state information, including a pointer to the task's context
@@ -81,22 +92,85 @@ typedef struct OSTaskControlBlock
     uOSBase_t*              puxEndOfStack;        /*< Points to the end of the stack on architectures where the stack grows up from low memory. */
 #endif
 
+#if ( OS_STACK_WATERMARK_ON!=0 )
+    uOS16_t                 usStackDepth;         /*< Depth of the stack in uOSStack_t, bounds the watermark scan. */
+#endif
+
+#if ( OSTIME_SLICE_ON!=0 )
+    uOSTick_t               uxTimeSliceTicks;     /*< Ticks the task runs before an equal priority task takes its turn, 0 for no turns. */
+    uOSTick_t               uxTimeSliceLeft;      /*< Ticks left of the current turn. */
+#endif
+
+#if ( OS_TASK_BUDGET_ON!=0 )
+    uOSTick_t               uxBudgetTicks;        /*< Ticks the task may run per period, 0 for no budget. */
+    uOSTick_t               uxBudgetPeriod;       /*< Ticks of a budget period. */
+    uOSTick_t               uxBudgetPeriodStart;  /*< Tick count the current period started at. */
+    uOSTick_t               uxBudgetLeft;         /*< Ticks left of the budget of the current period. */
+#endif
+
+#if ( OS_PREEMPT_THRESHOLD_ON!=0 )
+    uOSBase_t               uxPreemptThreshold;   /*< Only tasks above this priority preempt the task, not above the priority itself. */
+#endif
+
 #if ( OS_MUTEX_ON!=0 )
     uOSBase_t               uxBasePriority;       /*< The priority last assigned to the task - used by the priority inheritance mechanism. */
     uOSBase_t               uxMutexHoldNum;
+    struct tOSMutex*        ptMutexHoldList;      /*< The mutexes held by the task - used by the nested priority inheritance. */
+    struct tOSMutex*        ptMutexPended;        /*< The mutex the task is waiting for - used by the nested priority inheritance. */
+#if ( OS_RWLOCK_ON!=0 )
+    struct tOSRWLock*       ptRWLockHoldList;     /*< The RW locks held for writing by the task - used by the priority inheritance. */
+#endif
 #endif
 
     sOSBase_t               xID;
     
+#if ( OS_LATENCY_TRACE_ON!=0 )
+    uOS32_t                 uiWakeCycle;          /*< Cycle count when an ISR woke the task, 0 if not woken by an ISR. */
+#endif
+
+#if ( OS_TASK_IPC_ON!=0 )
+    tOSList_t               tIPCCallList;         /*< Clients waiting for the task to take their call, highest priority first. */
+    struct OSTaskControlBlock* ptIPCPartner;      /*< The server a client calls, or the client a server serves. */
+    uOS32_t                 uiIPCMsg;             /*< The message of a call, or the reply to it. */
+    uOS8_t                  ucIPCState;           /*< IPC state: None Receiving Serving Calling ReplyWait Replied. */
+#if ( OS_MUTEX_ON==0 )
+    uOSBase_t               uxIPCBasePriority;    /*< The priority a server returns to when it replies. */
+#endif
+#endif
+
 #if ( OS_TASK_SIGNAL_ON!=0 )                      /*< Task signal: SEM_SIG MSG_SIG MSG_SIG_OVERWRITE. */
-    volatile uOS8_t         ucSigState;           /*< Task signal state: NotWaiting Waiting GotSignal. */
-    volatile uOS32_t        uiSigValue;           /*< Task signal value: Msg or count. */
+    volatile uOS8_t         ucSigState[ OSTASK_SIGNAL_SLOTS ];    /*< Task signal state: NotWaiting Waiting GotSignal. */
+    volatile uOS32_t        uiSigValue[ OSTASK_SIGNAL_SLOTS ];    /*< Task signal value: Msg or count. */
 #endif
 
 } tOSTCB_t;
 
 typedef    tOSTCB_t*        OSTaskHandle_t;
 
+/* The running task. */
+extern tOSTCB_t * volatile gptCurrentTCB;
+
+#if ( OS_LATENCY_TRACE_ON!=0 )
+typedef struct tOSLatencyStats
+{
+    uOS32_t                 uiCount;              /*< Number of latencies measured. */
+    uOS32_t                 uiMin;                /*< Latencies in cycles. */
+    uOS32_t                 uiMax;
+    uOS32_t                 uiSum;
+    uOS32_t                 uiHist[ OSLATENCY_HIST_NUM ];
+} tOSLatencyStats_t;
+#endif //( OS_LATENCY_TRACE_ON!=0 )
+
+#if ( OS_STACK_WATERMARK_ON!=0 )
+typedef struct tOSTaskStackInfo
+{
+    OSTaskHandle_t          TaskHandle;
+    const char*             pcTaskName;
+    uOSBase_t               uxPriority;
+    uOSBase_t               uxStackHighWaterMark; /*< The minimum free stack space of the task since it was created, in words. */
+} tOSTaskStackInfo_t;
+#endif //( OS_STACK_WATERMARK_ON!=0 )
+
 uOSBase_t    OSTaskInit( void ) TINIUX_FUNCTION;
 OSTaskHandle_t OSTaskCreate(OSTaskFunction_t    pxTaskFunction,
                             void*               pvParameter,
@@ -106,6 +180,18 @@ OSTaskHandle_t OSTaskCreate(OSTaskFunction_t    pxTaskFunction,
 #if ( OS_MEMFREE_ON != 0 )
 void         OSTaskDelete( OSTaskHandle_t xTaskToDelete ) TINIUX_FUNCTION;
 #endif /* OS_MEMFREE_ON */
+#if ( OS_COOPERATIVE_ON!=0 ) || ( OS_PREEMPT_THRESHOLD_ON!=0 )
+uOSBase_t    OSTaskGetPreemptPriority( void ) TINIUX_FUNCTION;
+uOSBase_t    OSTaskGetMinPreemptPriority( void ) TINIUX_FUNCTION;
+#else
+#define      OSTaskGetPreemptPriority()     ( gptCurrentTCB->uxPriority )
+#define      OSTaskGetMinPreemptPriority()  ( gptCurrentTCB->uxPriority )
+#endif //( OS_COOPERATIVE_ON!=0 ) || ( OS_PREEMPT_THRESHOLD_ON!=0 )
+#if ( OS_PREEMPT_THRESHOLD_ON!=0 )
+uOSBase_t    OSTaskSetPreemptThreshold( OSTaskHandle_t const TaskHandle, uOSBase_t uxThreshold ) TINIUX_FUNCTION;
+uOSBase_t    OSTaskGetPreemptThreshold( OSTaskHandle_t const TaskHandle ) TINIUX_FUNCTION;
+#endif //( OS_PREEMPT_THRESHOLD_ON!=0 )
+void         OSTaskYield( void ) TINIUX_FUNCTION;
 void         OSTaskSleep( const uOSTick_t uxTicksToSleep ) TINIUX_FUNCTION;
 sOSBase_t    OSTaskSetID(OSTaskHandle_t TaskHandle, sOSBase_t xID) TINIUX_FUNCTION;
 sOSBase_t    OSTaskGetID(OSTaskHandle_t const TaskHandle) TINIUX_FUNCTION;
@@ -114,7 +200,8 @@ uOSBase_t    OSTaskGetPriorityFromISR( OSTaskHandle_t const TaskHandle ) TINIUX_
 
 void         OSTaskListEventAdd( tOSList_t * const ptEventList, const uOSTick_t uxTicksToWait ) TINIUX_FUNCTION;
 uOSBool_t    OSTaskListEventRemove( const tOSList_t * const ptEventList ) TINIUX_FUNCTION;
-void         OSTaskListReadyAdd(tOSTCB_t* ptTCB) TINIUX_FUNCTION;
+uOSBool_t    OSTaskListEventRemoveFromISR( const tOSList_t * const ptEventList ) TINIUX_FUNCTION;
+void         OSTaskListReadyAdd(tOSTCB_t* ptTCB) TINIUX_FAST_FUNCTION;
 uOSBase_t    OSTaskListReadyNum( uOSBase_t uxPriority ) TINIUX_FUNCTION;
 uOSBase_t    OSTaskListPendNum( void ) TINIUX_FUNCTION;
 uOSBase_t    OSTaskListReadyPoolNum( void ) TINIUX_FUNCTION;
@@ -122,10 +209,12 @@ OSTaskHandle_t OSTaskListPendHeadItem( void ) TINIUX_FUNCTION;
 OSTaskHandle_t OSTaskListReadyPoolHeadItem( void ) TINIUX_FUNCTION;
 
 void         OSTaskListPendSwitch( void ) TINIUX_FUNCTION;
-void         OSTaskSwitchContext( void ) TINIUX_FUNCTION;
+void         OSTaskSwitchContext( void ) TINIUX_FAST_FUNCTION;
 
 #if (OSTIME_SLICE_ON != 0U)
-uOSBool_t    OSTaskNeedTimeSlice( void ) TINIUX_FUNCTION;
+uOSBool_t    OSTaskNeedTimeSlice( const uOSTick_t uxTicks ) TINIUX_FUNCTION;
+void         OSTaskSetTimeSlice( OSTaskHandle_t const TaskHandle, uOSTick_t uxTicks ) TINIUX_FUNCTION;
+uOSTick_t    OSTaskGetTimeSlice( OSTaskHandle_t const TaskHandle ) TINIUX_FUNCTION;
 #endif //(OSTIME_SLICE_ON != 0U)
 void         OSTaskSuspend( OSTaskHandle_t TaskHandle ) TINIUX_FUNCTION;
 void         OSTaskResume( OSTaskHandle_t TaskHandle ) TINIUX_FUNCTION;
@@ -135,17 +224,55 @@ uOSBase_t    OSTaskGetCurrentTaskNum( void ) TINIUX_FUNCTION;
 OSTaskHandle_t OSGetCurrentTaskHandle( void ) TINIUX_FUNCTION;
 void         OSIdleTask( void *pvParameters) TINIUX_FUNCTION;
 
+#if ( OS_STACK_WATERMARK_ON!=0 )
+uOSBase_t    OSTaskGetStackHighWaterMark( OSTaskHandle_t const TaskHandle ) TINIUX_FUNCTION;
+uOSBase_t    OSTaskStackReport( tOSTaskStackInfo_t * const ptInfo, uOSBase_t uxMaxNum ) TINIUX_FUNCTION;
+#endif //( OS_STACK_WATERMARK_ON!=0 )
+
+#if ( OS_LATENCY_TRACE_ON!=0 )
+void         OSTaskLatencyGetStats( tOSLatencyStats_t * const ptStats ) TINIUX_FUNCTION;
+uOS32_t      OSTaskLatencyGetPercentile( uOSBase_t uxPercent ) TINIUX_FUNCTION;
+void         OSTaskLatencyReset( void ) TINIUX_FUNCTION;
+#endif //( OS_LATENCY_TRACE_ON!=0 )
+
+#if ( OS_TASK_BUDGET_ON!=0 )
+uOSBool_t    OSTaskBudgetCharge( const uOSTick_t uxTickCount, const uOSTick_t uxTicks ) TINIUX_FUNCTION;
+void         OSTaskSetBudget( OSTaskHandle_t const TaskHandle, uOSTick_t uxBudgetTicks, uOSTick_t uxPeriodTicks ) TINIUX_FUNCTION;
+uOSTick_t    OSTaskGetBudgetLeft( OSTaskHandle_t const TaskHandle ) TINIUX_FUNCTION;
+
+/* Provided by the application, called from the tick when a task runs out of budget. */
+extern void  OSTaskBudgetHook( OSTaskHandle_t TaskHandle, char * pcTaskName );
+#endif //( OS_TASK_BUDGET_ON!=0 )
+
+#if ( OS_STACK_OVERFLOW_HOOK_ON!=0 )
+/* Provided by the application, called on the stack overflow of a task. */
+extern void  OSStackOverflowHook( OSTaskHandle_t TaskHandle, char * pcTaskName );
+#endif //( OS_STACK_OVERFLOW_HOOK_ON!=0 )
+
 #if ( OS_MUTEX_ON!= 0 )
-void *       OSTaskGetMutexHolder( void ) TINIUX_FUNCTION;
-uOSBool_t    OSTaskPriorityInherit( OSTaskHandle_t const MutexHolderTaskHandle ) TINIUX_FUNCTION;
-uOSBool_t    OSTaskPriorityDisinherit( OSTaskHandle_t const MutexHolderTaskHandle ) TINIUX_FUNCTION;
-void         OSTaskPriorityDisinheritAfterTimeout( OSTaskHandle_t const MutexHolderTaskHandle, uOSBase_t uxHighestPriorityWaitingTask ) TINIUX_FUNCTION;
+void *       OSTaskGetMutexHolder( void * const pvMutex ) TINIUX_FUNCTION;
+uOSBool_t    OSTaskPriorityInherit( void * const pvMutex ) TINIUX_FUNCTION;
+uOSBool_t    OSTaskPriorityDisinherit( OSTaskHandle_t const MutexHolderTaskHandle, void * const pvMutex ) TINIUX_FUNCTION;
+void         OSTaskPriorityDisinheritAfterTimeout( OSTaskHandle_t const MutexHolderTaskHandle ) TINIUX_FUNCTION;
+#if ( OS_RWLOCK_ON!=0 )
+void *       OSTaskGetRWLockWriter( void * const pvRWLock ) TINIUX_FUNCTION;
+uOSBool_t    OSTaskPriorityInheritRWLock( OSTaskHandle_t const WriterTaskHandle ) TINIUX_FUNCTION;
+uOSBool_t    OSTaskPriorityDisinheritRWLock( OSTaskHandle_t const WriterTaskHandle, void * const pvRWLock ) TINIUX_FUNCTION;
+#endif /* ( OS_RWLOCK_ON!=0 ) */
+#if ( OS_MUTEX_CEILING_ON!=0 )
+void         OSTaskPriorityCeiling( OSTaskHandle_t const MutexHolderTaskHandle, uOSBase_t uxCeilingPriority ) TINIUX_FUNCTION;
+#endif /* ( OS_MUTEX_CEILING_ON!=0 ) */
 #endif /* OS_MUTEX_ON */
 
 #if ( OS_TIMER_ON != 0 )
 void         OSTaskBlockAndPend( tOSList_t * const ptEventList, uOSTick_t uxTicksToWait, uOSBool_t bNeedSuspend ) TINIUX_FUNCTION;
 #endif /* ( OS_TIMER_ON!=0 ) */
 
+#if ( OS_TASK_IPC_ON!=0 )
+uOSBool_t    OSTaskCall( OSTaskHandle_t const ServerHandle, uOS32_t const uiMsg, uOS32_t * const puiReply, uOSTick_t const uxTicksToWait ) TINIUX_FUNCTION;
+uOSBool_t    OSTaskReplyWait( OSTaskHandle_t const ClientHandle, uOS32_t const uiReply, OSTaskHandle_t * const pClientHandle, uOS32_t * const puiMsg, uOSTick_t const uxTicksToWait ) TINIUX_FUNCTION;
+#endif //( OS_TASK_IPC_ON!=0 )
+
 #if ( OS_TASK_SIGNAL_ON!=0 )
 uOSBool_t    OSTaskSignalWait( uOSTick_t const uxTicksToWait) TINIUX_FUNCTION;
 uOSBool_t    OSTaskSignalEmit( OSTaskHandle_t const TaskHandle ) TINIUX_FUNCTION;
@@ -154,6 +281,10 @@ uOSBool_t    OSTaskSignalWaitMsg( uOS32_t* puiSigValue, uOSTick_t const uxTicksT
 uOSBool_t    OSTaskSignalEmitMsg( OSTaskHandle_t const TaskHandle, uOS32_t const uiSigValue, uOSBool_t bOverWrite ) TINIUX_FUNCTION;
 uOSBool_t    OSTaskSignalEmitMsgFromISR( OSTaskHandle_t const TaskHandle, uOS32_t const uiSigValue, uOSBool_t bOverWrite ) TINIUX_FUNCTION;
 uOSBool_t    OSTaskSignalClear( OSTaskHandle_t const TaskHandle ) TINIUX_FUNCTION;
+uOSBool_t    OSTaskSignalWaitIndexed( uOSBase_t uxIndex, uOS32_t uiClearOnEntry, uOS32_t uiClearOnExit, uOS32_t* puiSigValue, uOSTick_t const uxTicksToWait ) TINIUX_FUNCTION;
+uOSBool_t    OSTaskSignalEmitIndexed( OSTaskHandle_t const TaskHandle, uOSBase_t uxIndex, uOS32_t const uiSigValue, eOSSigAction_t eAction ) TINIUX_FUNCTION;
+uOSBool_t    OSTaskSignalEmitIndexedFromISR( OSTaskHandle_t const TaskHandle, uOSBase_t uxIndex, uOS32_t const uiSigValue, eOSSigAction_t eAction ) TINIUX_FUNCTION;
+uOS32_t      OSTaskSignalClearIndexed( OSTaskHandle_t const TaskHandle, uOSBase_t uxIndex, uOS32_t uiClearMask ) TINIUX_FUNCTION;
 #endif
 
 #ifdef __cplusplus
@@ -0,0 +1,380 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#include "TINIUX.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( OS_TOPIC_ON!=0 )
+
+/* The data of a sample follows its header. */
+#define OSTOPIC_SAMPLE_HEAD_SIZE    ( ( uOSMemSize_t ) OSMEM_ALIGN_SIZE( sizeof( tOSTopicSample_t ) ) )
+#define OSTopicSampleData( ptSample )    ( ( void * ) ( ( uOS8_t * ) ( ptSample ) + OSTOPIC_SAMPLE_HEAD_SIZE ) )
+#define OSTopicSampleHead( pvSample )    ( ( tOSTopicSample_t * ) ( ( uOS8_t * ) ( pvSample ) - OSTOPIC_SAMPLE_HEAD_SIZE ) )
+
+static void OSTopicSampleFree( tOSTopic_t * const ptTopic, tOSTopicSample_t * const ptSample )
+{
+    /* THIS FUNCTION MUST BE CALLED WITH THE INTERRUPT LOCKED. */
+    ptSample->ptNext = ptTopic->ptFreeSample;
+    ptTopic->ptFreeSample = ptSample;
+}
+
+static void OSTopicSampleUnref( tOSTopic_t * const ptTopic, tOSTopicSample_t * const ptSample )
+{
+    /* THIS FUNCTION MUST BE CALLED WITH THE INTERRUPT LOCKED. */
+    /* Only the last holder frees the sample, a sample released twice is
+    already free and must not be put on the free list again. */
+    if( ptSample->uxRefCount > ( uOSBase_t ) 0U )
+    {
+        ( ptSample->uxRefCount )--;
+        if( ptSample->uxRefCount == ( uOSBase_t ) 0U )
+        {
+            OSTopicSampleFree( ptTopic, ptSample );
+        }
+    }
+}
+
+static tOSTopicSample_t * OSTopicSampleGet( tOSTopic_t * const ptTopic )
+{
+    /* THIS FUNCTION MUST BE CALLED WITH THE INTERRUPT LOCKED. */
+    tOSTopicSample_t * ptSample = ptTopic->ptFreeSample;
+
+    if( ptSample != OS_NULL )
+    {
+        ptTopic->ptFreeSample = ptSample->ptNext;
+        ptSample->ptNext = OS_NULL;
+        ptSample->uxRefCount = ( uOSBase_t ) 0U;
+    }
+
+    return ptSample;
+}
+
+static uOSBool_t OSTopicSubPut( tOSTopicSub_t * const ptSub, tOSTopicSample_t * const ptSample )
+{
+    /* THIS FUNCTION MUST BE CALLED WITH THE INTERRUPT LOCKED. */
+    uOSBase_t uxIndex = ( uOSBase_t ) 0U;
+
+    if( ( ptSub->ucPolicy == OSTOPIC_LATEST ) && ( ptSub->uxNum > ( uOSBase_t ) 0U ) )
+    {
+        /* The newest sample replaces the one not received yet. */
+        OSTopicSampleUnref( ptSub->ptTopic, ptSub->pptSample[ ptSub->uxHead ] );
+        ptSub->pptSample[ ptSub->uxHead ] = ptSample;
+    }
+    else if( ptSub->uxNum >= ptSub->uxDepth )
+    {
+        ( ptSub->uxDropNum )++;
+        return OS_FALSE;
+    }
+    else
+    {
+        uxIndex = ptSub->uxHead + ptSub->uxNum;
+        if( uxIndex >= ptSub->uxDepth )
+        {
+            uxIndex -= ptSub->uxDepth;
+        }
+        ptSub->pptSample[ uxIndex ] = ptSample;
+        ( ptSub->uxNum )++;
+    }
+    ( ptSample->uxRefCount )++;
+
+    return OS_TRUE;
+}
+
+static uOSBase_t OSTopicPublishLocked( tOSTopic_t * const ptTopic, tOSTopicSample_t * const ptSample, uOSBool_t bFromISR, uOSBool_t * const pbNeedSchedule )
+{
+    /* THIS FUNCTION MUST BE CALLED WITH THE INTERRUPT LOCKED. */
+    tOSTopicSub_t * ptSub = OS_NULL;
+    uOSBase_t uxNum = ( uOSBase_t ) 0U;
+    uOSBool_t bWoken = OS_FALSE;
+
+    /* Only the pointer to the sample is queued, the data is never copied. */
+    for( ptSub = ptTopic->ptSubList; ptSub != OS_NULL; ptSub = ptSub->ptNext )
+    {
+        if( OSTopicSubPut( ptSub, ptSample ) != OS_FALSE )
+        {
+            uxNum++;
+
+            if( OSListIsEmpty( &( ptSub->tTaskListEventSub ) ) == OS_FALSE )
+            {
+                if( bFromISR != OS_FALSE )
+                {
+                    bWoken = OSTaskListEventRemoveFromISR( &( ptSub->tTaskListEventSub ) );
+                }
+                else
+                {
+                    bWoken = OSTaskListEventRemove( &( ptSub->tTaskListEventSub ) );
+                }
+                if( bWoken != OS_FALSE )
+                {
+                    *pbNeedSchedule = OS_TRUE;
+                }
+            }
+        }
+    }
+
+    /* Nobody took the sample. */
+    if( ptSample->uxRefCount == ( uOSBase_t ) 0U )
+    {
+        OSTopicSampleFree( ptTopic, ptSample );
+    }
+
+    return uxNum;
+}
+
+/* All the samples of a topic are allocated here, publishing never allocates. */
+OSTopicHandle_t OSTopicCreate( uOSMemSize_t uxSampleSize, uOSBase_t uxSampleNum )
+{
+    tOSTopic_t *ptNewTopic = OS_NULL;
+    uOS8_t *pucSample = OS_NULL;
+    uOSMemSize_t uxBlockSize = ( uOSMemSize_t ) 0U;
+    uOSBase_t x = ( uOSBase_t ) 0U;
+
+    uxBlockSize = OSTOPIC_SAMPLE_HEAD_SIZE + ( uOSMemSize_t ) OSMEM_ALIGN_SIZE( uxSampleSize );
+
+    ptNewTopic = ( tOSTopic_t * ) OSMemMalloc( ( uOSMemSize_t ) OSMEM_ALIGN_SIZE( sizeof( tOSTopic_t ) ) + uxBlockSize * uxSampleNum );
+    if( ptNewTopic != OS_NULL )
+    {
+        ptNewTopic->uxSampleSize = uxSampleSize;
+        ptNewTopic->ptSubList = OS_NULL;
+        ptNewTopic->ptFreeSample = OS_NULL;
+
+        pucSample = ( uOS8_t * ) ptNewTopic + OSMEM_ALIGN_SIZE( sizeof( tOSTopic_t ) );
+        for( x = ( uOSBase_t ) 0U; x < uxSampleNum; x++ )
+        {
+            OSTopicSampleFree( ptNewTopic, ( tOSTopicSample_t * ) pucSample );
+            pucSample += uxBlockSize;
+        }
+    }
+    return ( OSTopicHandle_t ) ptNewTopic;
+}
+
+sOSBase_t OSTopicSetID(OSTopicHandle_t TopicHandle, sOSBase_t xID)
+{
+    if(TopicHandle == OS_NULL)
+    {
+        return 1;
+    }
+    OSIntLock();
+    {
+        TopicHandle->xID = xID;
+    }
+    OSIntUnlock();
+
+    return 0;
+}
+
+sOSBase_t OSTopicGetID(OSTopicHandle_t const TopicHandle)
+{
+    sOSBase_t xID = 0;
+
+    OSIntLock();
+    if(TopicHandle != OS_NULL)
+    {
+        xID = TopicHandle->xID;
+    }
+    OSIntUnlock();
+
+    return xID;
+}
+
+/* A latest-only subscriber keeps a single sample whatever its depth. */
+OSTopicSubHandle_t OSTopicSubscribe( OSTopicHandle_t TopicHandle, uOSBase_t uxDepth, uOS8_t ucPolicy )
+{
+    tOSTopic_t * const ptTopic = ( tOSTopic_t * ) TopicHandle;
+    tOSTopicSub_t *ptNewSub = OS_NULL;
+
+    if( ( ucPolicy == OSTOPIC_LATEST ) || ( uxDepth == ( uOSBase_t ) 0U ) )
+    {
+        uxDepth = ( uOSBase_t ) 1U;
+    }
+
+    ptNewSub = ( tOSTopicSub_t * ) OSMemMalloc( ( uOSMemSize_t ) OSMEM_ALIGN_SIZE( sizeof( tOSTopicSub_t ) ) + sizeof( tOSTopicSample_t * ) * uxDepth );
+    if( ptNewSub != OS_NULL )
+    {
+        ptNewSub->ptTopic = ptTopic;
+        ptNewSub->pptSample = ( tOSTopicSample_t ** ) ( ( uOS8_t * ) ptNewSub + OSMEM_ALIGN_SIZE( sizeof( tOSTopicSub_t ) ) );
+        ptNewSub->uxDepth = uxDepth;
+        ptNewSub->uxHead = ( uOSBase_t ) 0U;
+        ptNewSub->uxNum = ( uOSBase_t ) 0U;
+        ptNewSub->uxDropNum = ( uOSBase_t ) 0U;
+        ptNewSub->ucPolicy = ucPolicy;
+
+        OSListInit( &( ptNewSub->tTaskListEventSub ) );
+
+        OSIntLock();
+        {
+            ptNewSub->ptNext = ptTopic->ptSubList;
+            ptTopic->ptSubList = ptNewSub;
+        }
+        OSIntUnlock();
+    }
+    return ( OSTopicSubHandle_t ) ptNewSub;
+}
+
+/* Returns a free sample to be written and published, OS_NULL if all the
+samples are held by subscribers. */
+void* OSTopicSampleAlloc( OSTopicHandle_t TopicHandle )
+{
+    tOSTopic_t * const ptTopic = ( tOSTopic_t * ) TopicHandle;
+    tOSTopicSample_t * ptSample = OS_NULL;
+
+    OSIntLock();
+    {
+        ptSample = OSTopicSampleGet( ptTopic );
+    }
+    OSIntUnlock();
+
+    return ( ptSample != OS_NULL ) ? OSTopicSampleData( ptSample ) : OS_NULL;
+}
+
+void* OSTopicSampleAllocFromISR( OSTopicHandle_t TopicHandle )
+{
+    tOSTopic_t * const ptTopic = ( tOSTopic_t * ) TopicHandle;
+    tOSTopicSample_t * ptSample = OS_NULL;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+
+    uxIntSave = OSIntMaskFromISR();
+    {
+        ptSample = OSTopicSampleGet( ptTopic );
+    }
+    OSIntUnmaskFromISR( uxIntSave );
+
+    return ( ptSample != OS_NULL ) ? OSTopicSampleData( ptSample ) : OS_NULL;
+}
+
+/* The sample belongs to the subscribers after this, returns the number of
+subscribers it was delivered to. */
+uOSBase_t OSTopicPublish( OSTopicHandle_t TopicHandle, void* pvSample )
+{
+    tOSTopic_t * const ptTopic = ( tOSTopic_t * ) TopicHandle;
+    uOSBase_t uxNum = ( uOSBase_t ) 0U;
+    uOSBool_t bNeedSchedule = OS_FALSE;
+
+    OSIntLock();
+    {
+        uxNum = OSTopicPublishLocked( ptTopic, OSTopicSampleHead( pvSample ), OS_FALSE, &bNeedSchedule );
+        if( bNeedSchedule != OS_FALSE )
+        {
+            OSSchedule();
+        }
+    }
+    OSIntUnlock();
+
+    return uxNum;
+}
+
+uOSBase_t OSTopicPublishFromISR( OSTopicHandle_t TopicHandle, void* pvSample )
+{
+    tOSTopic_t * const ptTopic = ( tOSTopic_t * ) TopicHandle;
+    uOSBase_t uxNum = ( uOSBase_t ) 0U;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+    uOSBool_t bNeedSchedule = OS_FALSE;
+
+    uxIntSave = OSIntMaskFromISR();
+    {
+        uxNum = OSTopicPublishLocked( ptTopic, OSTopicSampleHead( pvSample ), OS_TRUE, &bNeedSchedule );
+    }
+    OSIntUnmaskFromISR( uxIntSave );
+
+    if(SCHEDULER_RUNNING == OSScheduleGetState())
+    {
+        OSScheduleFromISR( bNeedSchedule );
+    }
+
+    return uxNum;
+}
+
+/* Returns the oldest sample of the subscriber, OS_NULL on timeout. The
+sample stays valid until it is given back with OSTopicRelease. */
+void* OSTopicReceive( OSTopicSubHandle_t SubHandle, uOSTick_t uxTicksToWait )
+{
+    tOSTopicSub_t * const ptSub = ( tOSTopicSub_t * ) SubHandle;
+    tOSTopicSample_t * ptSample = OS_NULL;
+
+    OSIntLock();
+    {
+        if( ( ptSub->uxNum == ( uOSBase_t ) 0U ) && ( uxTicksToWait > ( uOSTick_t ) 0 ) )
+        {
+            OSTaskListEventAdd( &( ptSub->tTaskListEventSub ), uxTicksToWait );
+
+            OSSchedule();
+        }
+    }
+    OSIntUnlock();
+
+    OSIntLock();
+    {
+        if( ptSub->uxNum > ( uOSBase_t ) 0U )
+        {
+            ptSample = ptSub->pptSample[ ptSub->uxHead ];
+            ( ptSub->uxHead )++;
+            if( ptSub->uxHead >= ptSub->uxDepth )
+            {
+                ptSub->uxHead = ( uOSBase_t ) 0U;
+            }
+            ( ptSub->uxNum )--;
+        }
+    }
+    OSIntUnlock();
+
+    return ( ptSample != OS_NULL ) ? OSTopicSampleData( ptSample ) : OS_NULL;
+}
+
+/* The last subscriber releasing a sample gives it back to the topic. */
+void OSTopicRelease( OSTopicSubHandle_t SubHandle, void* pvSample )
+{
+    tOSTopicSub_t * const ptSub = ( tOSTopicSub_t * ) SubHandle;
+
+    OSIntLock();
+    {
+        OSTopicSampleUnref( ptSub->ptTopic, OSTopicSampleHead( pvSample ) );
+    }
+    OSIntUnlock();
+}
+
+uOSBase_t OSTopicGetDropNum( OSTopicSubHandle_t const SubHandle )
+{
+    return SubHandle->uxDropNum;
+}
+
+#endif //( OS_TOPIC_ON!=0 )
+
+#ifdef __cplusplus
+}
+#endif
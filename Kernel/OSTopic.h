@@ -0,0 +1,112 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#ifndef __OS_TOPIC_H_
+#define __OS_TOPIC_H_
+
+#include "OSType.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( OS_TOPIC_ON!=0 )
+
+// The subscriber keeps only the newest sample.
+#define OSTOPIC_LATEST              ( 0U )
+// The subscriber keeps up to its depth of samples, newer samples are dropped while it is full.
+#define OSTOPIC_QUEUED              ( 1U )
+
+typedef struct tOSTopicSample
+{
+    struct tOSTopicSample *     ptNext;                 // Next free sample.
+    volatile uOSBase_t          uxRefCount;             // Number of subscribers holding the sample.
+} tOSTopicSample_t;
+
+typedef struct tOSTopic
+{
+    char                        pcTopicName[ OSNAME_MAX_LEN ];
+    tOSTopicSample_t *          ptFreeSample;           // Free samples of the topic.
+    uOSMemSize_t                uxSampleSize;           // Size of the data of a sample.
+
+    struct tOSTopicSub *        ptSubList;              // Subscribers of the topic.
+
+    sOSBase_t                   xID;
+} tOSTopic_t;
+
+typedef struct tOSTopicSub
+{
+    struct tOSTopicSub *        ptNext;                 // Next subscriber of the same topic.
+    tOSTopic_t *                ptTopic;
+
+    tOSList_t                   tTaskListEventSub;      // Receive TaskList;
+
+    tOSTopicSample_t **         pptSample;              // Samples waiting to be received.
+    uOSBase_t                   uxDepth;
+    uOSBase_t                   uxHead;
+    volatile uOSBase_t          uxNum;
+
+    volatile uOSBase_t          uxDropNum;              // Samples dropped while the subscriber was full.
+    uOS8_t                      ucPolicy;
+} tOSTopicSub_t;
+
+typedef    tOSTopic_t*          OSTopicHandle_t;
+typedef    tOSTopicSub_t*       OSTopicSubHandle_t;
+
+OSTopicHandle_t    OSTopicCreate( uOSMemSize_t uxSampleSize, uOSBase_t uxSampleNum ) TINIUX_FUNCTION;
+
+sOSBase_t          OSTopicSetID(OSTopicHandle_t TopicHandle, sOSBase_t xID) TINIUX_FUNCTION;
+sOSBase_t          OSTopicGetID(OSTopicHandle_t const TopicHandle) TINIUX_FUNCTION;
+
+OSTopicSubHandle_t OSTopicSubscribe( OSTopicHandle_t TopicHandle, uOSBase_t uxDepth, uOS8_t ucPolicy ) TINIUX_FUNCTION;
+
+void*              OSTopicSampleAlloc( OSTopicHandle_t TopicHandle ) TINIUX_FUNCTION;
+void*              OSTopicSampleAllocFromISR( OSTopicHandle_t TopicHandle ) TINIUX_FUNCTION;
+uOSBase_t          OSTopicPublish( OSTopicHandle_t TopicHandle, void* pvSample ) TINIUX_FUNCTION;
+uOSBase_t          OSTopicPublishFromISR( OSTopicHandle_t TopicHandle, void* pvSample ) TINIUX_FUNCTION;
+
+void*              OSTopicReceive( OSTopicSubHandle_t SubHandle, uOSTick_t uxTicksToWait ) TINIUX_FUNCTION;
+void               OSTopicRelease( OSTopicSubHandle_t SubHandle, void* pvSample ) TINIUX_FUNCTION;
+uOSBase_t          OSTopicGetDropNum( OSTopicSubHandle_t const SubHandle ) TINIUX_FUNCTION;
+
+#endif //( OS_TOPIC_ON!=0 )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__OS_TOPIC_H_
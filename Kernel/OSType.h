@@ -45,8 +45,13 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 extern "C" {
 #endif
 
-#define TINIUX_DATA
-#define TINIUX_FUNCTION
+/* A port may place the kernel in its own sections. */
+#ifndef TINIUX_DATA
+  #define TINIUX_DATA
+#endif
+#ifndef TINIUX_FUNCTION
+  #define TINIUX_FUNCTION
+#endif
 
 typedef void (*OSTaskFunction_t)( void * );
 typedef void (*OSTimerFunction_t)(void * );
@@ -124,11 +129,39 @@ typedef enum {OS_SUCESS = 0, OS_ERROR = !OS_SUCESS} uOSStatus_t;
     #define     OSQUICK_GET_PRIORITY        ( 0U )
 #endif
 
-// Use time slice mode or not
+// Schedule cooperatively only or not, a task keeps the CPU until it blocks or yields
+#ifndef SETOS_COOPERATIVE_ON
+  #define    OS_COOPERATIVE_ON         ( 0U )
+#else
+  #define    OS_COOPERATIVE_ON         ( SETOS_COOPERATIVE_ON )
+#endif
+
+// Give each task a preemption threshold, only tasks above it preempt the running task
+#ifndef SETOS_PREEMPT_THRESHOLD_ON
+  #define    OS_PREEMPT_THRESHOLD_ON   ( 0U )
+#else
+  #define    OS_PREEMPT_THRESHOLD_ON   ( SETOS_PREEMPT_THRESHOLD_ON )
+#endif
+
+// Give tasks a CPU budget per period, a task out of budget sleeps until its next period
+#ifndef SETOS_TASK_BUDGET_ON
+  #define    OS_TASK_BUDGET_ON         ( 0U )
+#else
+  #define    OS_TASK_BUDGET_ON         ( SETOS_TASK_BUDGET_ON )
+#endif
+
+// Use time slice mode or not, there is no time slice in cooperative mode
 #ifndef SETOS_TIME_SLICE_ON
-  #define    OSTIME_SLICE_ON           ( 1U )
+  #define    OSTIME_SLICE_ON           ( ( OS_COOPERATIVE_ON ) == 0U )
+#else
+  #define    OSTIME_SLICE_ON           ( ( SETOS_TIME_SLICE_ON ) && ( ( OS_COOPERATIVE_ON ) == 0U ) )
+#endif
+
+// Default ticks a task runs before the next task of the same priority takes its turn
+#ifndef SETOS_TIME_SLICE_TICKS
+  #define    OSTIME_SLICE_TICKS        ( 1U )
 #else
-  #define    OSTIME_SLICE_ON           ( SETOS_TIME_SLICE_ON )
+  #define    OSTIME_SLICE_TICKS        ( SETOS_TIME_SLICE_TICKS )
 #endif
 
 // The total heap size of the TINIUX
@@ -145,6 +178,95 @@ typedef enum {OS_SUCESS = 0, OS_ERROR = !OS_SUCESS} uOSStatus_t;
   #define    OSMINIMAL_STACK_SIZE      ( SETOS_MINIMAL_STACK_SIZE )
 #endif
 
+// Measure the stack high water mark of tasks or not
+#ifndef SETOS_STACK_WATERMARK_ON
+  #define    OS_STACK_WATERMARK_ON     ( 0U )
+#else
+  #define    OS_STACK_WATERMARK_ON     ( SETOS_STACK_WATERMARK_ON )
+#endif
+
+// Call OSStackOverflowHook() on task stack overflow instead of hanging
+#ifndef SETOS_STACK_OVERFLOW_HOOK_ON
+  #define    OS_STACK_OVERFLOW_HOOK_ON ( 0U )
+#else
+  #define    OS_STACK_OVERFLOW_HOOK_ON ( SETOS_STACK_OVERFLOW_HOOK_ON )
+#endif
+
+// Place the switch and tick path in the port's tightly coupled or RAM sections or not, Cortex-M4/M7 only
+#ifndef SETOS_TCM_PLACEMENT_ON
+  #define    OS_TCM_PLACEMENT_ON       ( 0U )
+#else
+  #define    OS_TCM_PLACEMENT_ON       ( SETOS_TCM_PLACEMENT_ON )
+#endif
+
+#if ( OS_TCM_PLACEMENT_ON!=0 )
+  #define    TINIUX_FAST_DATA          FitTCM_DATA
+  #define    TINIUX_FAST_FUNCTION      FitTCM_FUNCTION
+#else
+  #define    TINIUX_FAST_DATA          TINIUX_DATA
+  #define    TINIUX_FAST_FUNCTION      TINIUX_FUNCTION
+#endif
+
+// Use a MPU guard region at the bottom of the running task's stack or not, Cortex-M3/M4/M7 only
+#ifndef SETOS_MPU_STACK_GUARD_ON
+  #define    OS_MPU_STACK_GUARD_ON     ( 0U )
+#else
+  #define    OS_MPU_STACK_GUARD_ON     ( SETOS_MPU_STACK_GUARD_ON )
+#endif
+
+// Provide the cycle counter of the port for measurement or not
+#ifndef SETOS_CYCLE_COUNTER_ON
+  #define    OS_CYCLE_COUNTER_ON       ( 0U )
+#else
+  #define    OS_CYCLE_COUNTER_ON       ( SETOS_CYCLE_COUNTER_ON )
+#endif
+
+// Trace the latency from an ISR waking a task to the task running or not, it needs the cycle counter
+#ifndef SETOS_LATENCY_TRACE_ON
+  #define    OS_LATENCY_TRACE_ON       ( 0U )
+#else
+  #define    OS_LATENCY_TRACE_ON       ( ( SETOS_LATENCY_TRACE_ON ) && ( OS_CYCLE_COUNTER_ON ) )
+#endif
+
+// Report the cycles spent in the boot stages to OSBootProfileHook() or not, it needs the cycle counter
+#ifndef SETOS_BOOT_PROFILE_ON
+  #define    OS_BOOT_PROFILE_ON        ( 0U )
+#else
+  #define    OS_BOOT_PROFILE_ON        ( ( SETOS_BOOT_PROFILE_ON ) && ( OS_CYCLE_COUNTER_ON ) )
+#endif
+
+// Profile the interrupt masked sections of the kernel or not, it needs the cycle counter
+#ifndef SETOS_INT_PROFILE_ON
+  #define    OS_INT_PROFILE_ON         ( 0U )
+#else
+  #define    OS_INT_PROFILE_ON         ( ( SETOS_INT_PROFILE_ON ) && ( OS_CYCLE_COUNTER_ON ) )
+#endif
+
+#if ( OS_INT_PROFILE_ON!=0 )
+// Number of call sites with the longest masked sections to keep
+#ifndef SETOS_INT_PROFILE_NUM
+  #define    OSINT_PROFILE_NUM         ( 8U )
+#else
+  #define    OSINT_PROFILE_NUM         ( SETOS_INT_PROFILE_NUM )
+#endif
+#endif //( OS_INT_PROFILE_ON!=0 )
+
+#if ( OS_LATENCY_TRACE_ON!=0 )
+// Number of latency histogram buckets, the last one counts all longer latencies
+#ifndef SETOS_LATENCY_HIST_NUM
+  #define    OSLATENCY_HIST_NUM        ( 16U )
+#else
+  #define    OSLATENCY_HIST_NUM        ( SETOS_LATENCY_HIST_NUM )
+#endif
+
+// Width of a latency histogram bucket, ( 1 << OSLATENCY_HIST_SHIFT ) cycles
+#ifndef SETOS_LATENCY_HIST_SHIFT
+  #define    OSLATENCY_HIST_SHIFT      ( 6U )
+#else
+  #define    OSLATENCY_HIST_SHIFT      ( SETOS_LATENCY_HIST_SHIFT )
+#endif
+#endif //( OS_LATENCY_TRACE_ON!=0 )
+
 // Length of name(eg. task name, semaphore name, MsgQ name, Mutex name)
 #ifndef SETOS_MAX_NAME_LEN
   #define    OSNAME_MAX_LEN            ( 10U )
@@ -159,6 +281,13 @@ typedef enum {OS_SUCESS = 0, OS_ERROR = !OS_SUCESS} uOSStatus_t;
   #define    OS_MEMFREE_ON             ( SETOS_ENABLE_MEMFREE )
 #endif
 
+// Zero the whole heap in OSMemInit or not, OSMemCalloc() zeroes its blocks anyway
+#ifndef SETOS_MEM_ZERO_INIT_ON
+  #define    OS_MEM_ZERO_INIT_ON       ( 1U )
+#else
+  #define    OS_MEM_ZERO_INIT_ON       ( SETOS_MEM_ZERO_INIT_ON )
+#endif
+
 // Use low-power mode or not
 #ifndef SETOS_LOWPOWER_MODE
   #define    OS_LOWPOWER_ON            ( 0U )
@@ -215,6 +344,55 @@ typedef enum {OS_SUCESS = 0, OS_ERROR = !OS_SUCESS} uOSStatus_t;
   #define    OS_MUTEX_ON               ( SETOS_USE_MUTEX )
 #endif
 
+// Use immediate priority ceiling protocol for mutex or not
+#ifndef SETOS_MUTEX_CEILING_ON
+  #define    OS_MUTEX_CEILING_ON       ( 0U )
+#else
+  #define    OS_MUTEX_CEILING_ON       ( SETOS_MUTEX_CEILING_ON )
+#endif
+
+// The max depth of the nested priority inheritance chain
+#ifndef SETOS_MUTEX_INHERIT_DEPTH
+  #define    OSMUTEX_INHERIT_DEPTH     ( 4U )
+#else
+  #define    OSMUTEX_INHERIT_DEPTH     ( SETOS_MUTEX_INHERIT_DEPTH )
+#endif
+
+// Use reader-writer lock or not
+#ifndef SETOS_USE_RWLOCK
+  #define    OS_RWLOCK_ON              ( 0U )
+#else
+  #define    OS_RWLOCK_ON              ( SETOS_USE_RWLOCK )
+#endif
+
+// Use condition variable or not, off unless SETOS_USE_COND is set, it works with mutex only
+#ifndef SETOS_USE_COND
+  #define    OS_COND_ON                ( 0U )
+#else
+  #define    OS_COND_ON                ( ( SETOS_USE_COND ) && ( OS_MUTEX_ON ) )
+#endif
+
+// Use topic or not, one published sample is shared by all the subscribers
+#ifndef SETOS_USE_TOPIC
+  #define    OS_TOPIC_ON               ( 0U )
+#else
+  #define    OS_TOPIC_ON               ( SETOS_USE_TOPIC )
+#endif
+
+// Use latest-value mailbox or not, it is read without locking
+#ifndef SETOS_USE_MAILBOX
+  #define    OS_MAILBOX_ON             ( 0U )
+#else
+  #define    OS_MAILBOX_ON             ( SETOS_USE_MAILBOX )
+#endif
+
+// Use priority message queue or not, up to 32 message priorities with a ring each
+#ifndef SETOS_USE_PRIO_MSGQ
+  #define    OS_PRIO_MSGQ_ON           ( 0U )
+#else
+  #define    OS_PRIO_MSGQ_ON           ( SETOS_USE_PRIO_MSGQ )
+#endif
+
 // Use Timer or not
 #ifndef SETOS_USE_TIMER
   #define    OS_TIMER_ON               ( 1U )
@@ -231,12 +409,93 @@ typedef enum {OS_SUCESS = 0, OS_ERROR = !OS_SUCESS} uOSStatus_t;
 #endif
 #endif //( OS_MSGQ_ON!=0 )
 
+// Use synchronous task call and reply or not, a server runs at the priority of its client
+#ifndef SETOS_TASK_IPC_ON
+  #define    OS_TASK_IPC_ON            ( 0U )
+#else
+  #define    OS_TASK_IPC_ON            ( SETOS_TASK_IPC_ON )
+#endif
+
 #ifndef SETOS_TASK_SIGNAL_ON
   #define    OS_TASK_SIGNAL_ON         ( 1U )
 #else
   #define    OS_TASK_SIGNAL_ON         ( SETOS_TASK_SIGNAL_ON )
 #endif
 
+#if ( OS_TASK_SIGNAL_ON!=0 )
+// The number of signal slots of each task, slot 0 is used by the single slot API
+#ifndef SETOS_TASK_SIGNAL_SLOTS
+  #define    OSTASK_SIGNAL_SLOTS       ( 1U )
+#else
+  #define    OSTASK_SIGNAL_SLOTS       ( SETOS_TASK_SIGNAL_SLOTS )
+#endif
+#endif //( OS_TASK_SIGNAL_ON!=0 )
+
+// Use run-to-completion basic tasks or not, they run one after another on the stack of one task
+#ifndef SETOS_BASIC_TASK_ON
+  #define    OS_BASIC_TASK_ON          ( 0U )
+#else
+  #define    OS_BASIC_TASK_ON          ( ( SETOS_BASIC_TASK_ON ) && ( OS_TASK_SIGNAL_ON ) )
+#endif
+
+#if ( OS_BASIC_TASK_ON!=0 )
+// Priority of the task running the basic tasks
+#ifndef SETOS_BASIC_TASK_PRIORITY
+  #define    OSBASIC_TASK_PRIO         ( OSHIGHEAST_PRIORITY - 1 )
+#else
+  #define    OSBASIC_TASK_PRIO         ( SETOS_BASIC_TASK_PRIORITY )
+#endif
+// Size of the stack shared by the basic tasks, in words
+#ifndef SETOS_BASIC_TASK_STACK_SIZE
+  #define    OSBASIC_TASK_STACK_SIZE   ( OSMINIMAL_STACK_SIZE )
+#else
+  #define    OSBASIC_TASK_STACK_SIZE   ( SETOS_BASIC_TASK_STACK_SIZE )
+#endif
+// Number of basic task priorities
+#ifndef SETOS_BASIC_TASK_PRIORITIES
+  #define    OSBASIC_PRIORITIES        ( 4U )
+#else
+  #define    OSBASIC_PRIORITIES        ( SETOS_BASIC_TASK_PRIORITIES )
+#endif
+#endif //( OS_BASIC_TASK_ON!=0 )
+
+// Use active objects or not, they are state machines run by the basic tasks
+#ifndef SETOS_ACTIVE_ON
+  #define    OS_ACTIVE_ON              ( 0U )
+#else
+  #define    OS_ACTIVE_ON              ( ( SETOS_ACTIVE_ON ) && ( OS_BASIC_TASK_ON ) )
+#endif
+
+#if ( OS_ACTIVE_ON!=0 )
+// Maximum number of active objects, up to 32
+#ifndef SETOS_ACTIVE_MAX_NUM
+  #define    OSACTIVE_MAX_NUM          ( 8U )
+#else
+  #define    OSACTIVE_MAX_NUM          ( SETOS_ACTIVE_MAX_NUM )
+#endif
+#if ( OSACTIVE_MAX_NUM > 32 )
+  #error "SETOS_ACTIVE_MAX_NUM is above 32, the subscribers of a signal are a 32-bit mask"
+#endif
+// Signals below this can be subscribed to
+#ifndef SETOS_ACTIVE_MAX_SIGNAL
+  #define    OSACTIVE_MAX_SIGNAL       ( 32U )
+#else
+  #define    OSACTIVE_MAX_SIGNAL       ( SETOS_ACTIVE_MAX_SIGNAL )
+#endif
+// Maximum nesting depth of the states, including the top state
+#ifndef SETOS_ACTIVE_MAX_NEST
+  #define    OSACTIVE_MAX_NEST         ( 6U )
+#else
+  #define    OSACTIVE_MAX_NEST         ( SETOS_ACTIVE_MAX_NEST )
+#endif
+// Number of event pools
+#ifndef SETOS_EVENT_POOL_NUM
+  #define    OSEVENT_POOL_NUM          ( 3U )
+#else
+  #define    OSEVENT_POOL_NUM          ( SETOS_EVENT_POOL_NUM )
+#endif
+#endif //( OS_ACTIVE_ON!=0 )
+
 // Milliseconds to OS Ticks
 #define      OSM2T( x )                ( ( uOSTick_t )( ( x )*( OSTICK_RATE_HZ/1000.0 ) ) )
 // Frequency to OS Ticks
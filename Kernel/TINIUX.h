@@ -52,7 +52,14 @@ extern "C" {
 #include "OSMsgQ.h"
 #include "OSSem.h"
 #include "OSMutex.h"
+#include "OSRWLock.h"
+#include "OSCond.h"
+#include "OSTopic.h"
+#include "OSMailbox.h"
+#include "OSPrioMsgQ.h"
 #include "OSTimer.h"
+#include "OSBasicTask.h"
+#include "OSActive.h"
 
 #define MAJOR_VERSION        3
 #define MINOR_VERSION        0